@@ -114,6 +114,7 @@
 #include "testM3.h"
 #include "testMapRange.h"
 #include "testMapSupport.h"
+#include "testMarkovProcess.h"
 #include "testMasterRotate.h"
 #include "testMaterial.h"
 #include "testMathSupport.h"
@@ -158,6 +159,7 @@
 #include "testVolumes.h"
 #include "testWorkData.h"
 #include "testWrapper.h"
+#include "testWWGOctree.h"
 #include "testWriteSupport.h"
 #include "testXML.h"
 
@@ -879,20 +881,22 @@ processTest(const int type,const int extra)
       std::cout<<"testGenerateSurf     (2)"<<std::endl;
       std::cout<<"testInputParam       (3)"<<std::endl;
       std::cout<<"testLineTrack        (4)"<<std::endl;
-      std::cout<<"testObjectRegister   (5)"<<std::endl;
-      std::cout<<"testObjectTrackAct   (6)"<<std::endl;
-      std::cout<<"testObjSurfMap       (7)"<<std::endl;
-      std::cout<<"testObjTrackItem     (8)"<<std::endl;
-      std::cout<<"testPipeLine         (9)"<<std::endl;
-      std::cout<<"testPipeUnit        (10)"<<std::endl;
-      std::cout<<"testSimpleObj       (11)"<<std::endl;
-      std::cout<<"testSurfDIter       (12)"<<std::endl;
-      std::cout<<"testSurfDivide      (13)"<<std::endl;
-      std::cout<<"testSurfEqual       (14)"<<std::endl;
-      std::cout<<"testSurfExpand      (15)"<<std::endl;
-      std::cout<<"testSurfRegister    (16)"<<std::endl;
-      std::cout<<"testVolumes         (17)"<<std::endl;
-      std::cout<<"testWrapper         (18)"<<std::endl;
+      std::cout<<"testMarkovProcess    (5)"<<std::endl;
+      std::cout<<"testObjectRegister   (6)"<<std::endl;
+      std::cout<<"testObjectTrackAct   (7)"<<std::endl;
+      std::cout<<"testObjSurfMap       (8)"<<std::endl;
+      std::cout<<"testObjTrackItem     (9)"<<std::endl;
+      std::cout<<"testPipeLine        (10)"<<std::endl;
+      std::cout<<"testPipeUnit        (11)"<<std::endl;
+      std::cout<<"testSimpleObj       (12)"<<std::endl;
+      std::cout<<"testSurfDIter       (13)"<<std::endl;
+      std::cout<<"testSurfDivide      (14)"<<std::endl;
+      std::cout<<"testSurfEqual       (15)"<<std::endl;
+      std::cout<<"testSurfExpand      (16)"<<std::endl;
+      std::cout<<"testSurfRegister    (17)"<<std::endl;
+      std::cout<<"testVolumes         (18)"<<std::endl;
+      std::cout<<"testWrapper         (19)"<<std::endl;
+      std::cout<<"testWWGOctree       (20)"<<std::endl;
     }
   int index(1);
   if(type==index || type<0)
@@ -926,6 +930,14 @@ processTest(const int type,const int extra)
     }
   index++;
 
+  if(type==index || type<0)
+    {
+      testMarkovProcess A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
+  index++;
+
   if(type==index || type<0)
     {
       testObjectRegister A;
@@ -1036,6 +1048,14 @@ processTest(const int type,const int extra)
       const int X=A.applyTest(extra);
       if (X) return X;
     }
+  index++;
+  
+  if(type==index || type<0)
+    {
+      testWWGOctree A;
+      const int X=A.applyTest(extra);
+      if (X) return X;
+    }
 
   return 0;
 }
@@ -42,6 +42,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "Vec3D.h"
+#include "BBox.h"
 #include "support.h"
 #include "Surface.h"
 #include "Quadratic.h"
@@ -549,6 +550,10 @@ checkIntersect(const ContainedComp& CC,
   //  ELog::debugMethod DegA;
 
   const HeadRule& CCHR=CC.getOuterSurf();
+  // quick reject if the bounding boxes are separated
+  if (!CellObj.getBoundBox().intersects(CCHR.calcBoundBox()))
+    return 0;
+  
   const std::set<const Geometry::Surface*>& CCsurfSet=
     CCHR.getSurfaces();
   const HeadRule& CellHR=CellObj.getHeadRule();
@@ -568,7 +573,7 @@ checkIntersect(const ContainedComp& CC,
 	      SurInter::processPoint(SPtr,*ac,*bc);
 	    for(const Geometry::Vec3D& testPoint : intersectPoints)
 	      {
-		if (CellHR.isValid(testPoint) &&
+		if (CellObj.isValid(testPoint) &&
 		    CCHR.isValid(testPoint))
 		  return 1;
 	      }
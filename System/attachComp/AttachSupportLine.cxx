@@ -310,7 +310,8 @@ lineIntersect(Simulation& System,
   // construct lines 
 
   ModelSupport::LineTrack LT(APt,BPt);
-  LT.calculate(System);
+  if (LT.calculate(System))
+    ELog::EM<<"INIT POINT[error] == "<<APt<<ELog::endCrit;
 
   const std::vector<ModelSupport::LineUnit>&
     LUnits=LT.getTrackPts();
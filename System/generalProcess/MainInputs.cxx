@@ -169,6 +169,7 @@ createInputs(inputParam& IParam)
   IParam.regFlag("TW","tallyWeight");
   IParam.regItem("TX","Txml",1);
   IParam.regItem("targetType","targetType",1);
+  IParam.regItem("threads","threads");
   IParam.regDefItem<int>("u","units",1,0);
   IParam.regItem("validCheck","validCheck",1);
   IParam.regItem("validAll","validAll",0);
@@ -182,6 +183,7 @@ createInputs(inputParam& IParam)
   IParam.regItem("volCard","volCard");
   IParam.regDefItem<int>("VN","volNum",1,20000);
   IParam.regMulti("volCell","volCells",100,1,100);
+  IParam.regItem("volError","volError",1,2);
     
   IParam.regFlag("void","void");
   IParam.regMulti("voidObject","voidObject",1000);
@@ -208,6 +210,7 @@ createInputs(inputParam& IParam)
   IParam.regMulti("WRebase","weightRebase",100,1);
   IParam.regMulti("wDXT","weightDxtran",100,1);
   IParam.regMulti("wDD","weightDD",100,1);
+  IParam.regFlag("wAttnE","weightAttnEnergy");
 
 
   IParam.regMulti("wBIAS","wBIAS",1000,0);
@@ -222,6 +225,7 @@ createInputs(inputParam& IParam)
   IParam.regMulti("wwgE","wwgE",25,0);
   IParam.regMulti("wwgVTK","wwgVTK",30);
   IParam.regMulti("wwgActive","wwgActive",100,1);
+  IParam.regFlag("wwgBinary","wwgBinary");
   IParam.regMulti("wwgCADIS","wwgCADIS",30,1);
   IParam.regMulti("wwgNorm","wwgNorm",30,0);
   IParam.regMulti("wwgCreate","wwgCreate",100,1);
@@ -255,7 +259,7 @@ createInputs(inputParam& IParam)
   IParam.setDesc("c","Cells to protect");
   IParam.setDesc("cutWeight","Set the cut weights (wc1/wc2)" );
   IParam.setDesc("ECut","Cut energy");
-  IParam.setDesc("fem","Write out FEM mesh (finite element)");
+  IParam.setDesc("fem","Write out FEM mesh (finite element) [line/binary]");
   IParam.setDesc("femMesh","Define mesh for FEM mesh");
 
   IParam.setDesc("fullOR","Write out full X/Y/Z basis in objectRegister.txt");
@@ -329,14 +333,16 @@ createInputs(inputParam& IParam)
   IParam.setDesc("TW","Activate tally pd weight system");
   IParam.setDesc("Txml","Tally xml file");
   IParam.setDesc("targetType","Name of target type");
+  IParam.setDesc("threads","Threads for cell processing [0 : all cores]");
   IParam.setDesc("u","Units in cm");
   IParam.setDesc("um","Unset spherical void area (from imp=0)");
   IParam.setDesc("void","Adds the void card to the simulation");
   IParam.setDesc("voidObject","Sets material(s) of FC-object(s) by name");
   IParam.setDesc("volume","Create volume about point/radius for f4 tally");
   IParam.setDesc("volCells","Cells [object/range]");
+  IParam.setDesc("volError","Adaptive volume : RelErr [nStrata]");
   IParam.setDesc("volCard","set/delete the vol card");
-  IParam.setDesc("vtk","Write out VTK plot mesh");
+  IParam.setDesc("vtk","Write out VTK plot mesh [line/binary]");
   IParam.setDesc("vtkMesh","Define mesh for MD5/VTK");
   IParam.setDesc("vmat","Material sections to be written by vtk output");
   IParam.setDesc("VN","Number of points in the volume integration");
@@ -350,6 +356,7 @@ createInputs(inputParam& IParam)
   IParam.setDesc("wWWG","Weight WindowGenerator Mesh  ");
   IParam.setDesc("wwgCADIS","Single step evolve for the calculate for WWG/WWCell  ");
   IParam.setDesc("wwgMarkov","Evolve the calculate for WWG/WWCell  ");
+  IParam.setDesc("wwgBinary","Write wwinp as binary [wwinp.bin]");
   IParam.setDesc("wIMP","set imp: particle impValue object(s)  ");
   IParam.setDesc("wFCL","Forced Collision ");
   IParam.setDesc("wPWT","Photon Bias [set -wPWT help]");
@@ -357,6 +364,7 @@ createInputs(inputParam& IParam)
   IParam.setDesc("WTemp","Temperature correction for weights");
   IParam.setDesc("WRebase","Rebase the weights based on a cell");
   IParam.setDesc("WObject","Reconstruct weights base on cells");
+  IParam.setDesc("wAttnE","Scale track attenuation with 1/v energy term");
   IParam.setDesc("WP","Weight bias Point");
   IParam.setDesc("weightControl","Sets: energyCut scaleFactor minWeight");
   IParam.setDesc("wwgNorm"," normalization step : "
@@ -445,6 +445,8 @@ createSimulation(inputParam& IParam,
   SimPtr->setCellDNF(IParam.getDefValue<size_t>(0,"cellDNF"));
   // CNF split the cells
   SimPtr->setCellCNF(IParam.getDefValue<size_t>(0,"cellCNF"));
+  // threads for cell processing
+  SimPtr->setThreads(IParam.getDefValue<size_t>(1,"threads"));
 
   SimPtr->setCmdLine(cmdLine.str());        // set full command line
   
@@ -542,7 +544,6 @@ buildFullSimFLUKA(SimFLUKA* SimFLUKAPtr,
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimFLUKA");
 
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
   if (IParam.flag("noVariables"))
     SimFLUKAPtr->setNoVariables();
@@ -565,12 +566,7 @@ buildFullSimFLUKA(SimFLUKA* SimFLUKAPtr,
   //  SimFLUKAPtr->masterSourceRotation();
   // Ensure we done loop
 
-  do
-    {
-      SimProcess::writeIndexSimFLUKA(*SimFLUKAPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSimFLUKA(*SimFLUKAPtr,OName,multi);
 
   return;
 }
@@ -590,7 +586,6 @@ buildFullSimPHITS(SimPHITS* SimPHITSPtr,
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimPHITS");
 
   // Definitions section
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
 
   phitsSystem::setDefaultPhysics(*SimPHITSPtr,IParam);
@@ -606,12 +601,7 @@ buildFullSimPHITS(SimPHITS* SimPHITSPtr,
   SDef::sourceSelection(*SimPHITSPtr,IParam);
   //  SimPHITSPtr->masterSourceRotation();
   // Ensure we done loop
-  do
-    {
-      SimProcess::writeIndexSimPHITS(*SimPHITSPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSimPHITS(*SimPHITSPtr,OName,multi);
 
   return;
 }
@@ -630,7 +620,6 @@ buildFullSimMCNP(SimMCNP* SimMCPtr,
 {
   ELog::RegMethod RegA("MainProcess[F]","buildFullSimMCNP");
   // Definitions section 
-  int MCIndex(0);
   const int multi=IParam.getValue<int>("multi");
 
 
@@ -652,12 +641,7 @@ buildFullSimMCNP(SimMCNP* SimMCPtr,
   //  SimMCPtr->masterSourceRotation();
   // Ensure we done loop
 
-  do
-    {
-      SimProcess::writeIndexSim(*SimMCPtr,OName,MCIndex);
-      MCIndex++;
-    }
-  while(MCIndex<multi);
+  SimProcess::writeMultiSim(*SimMCPtr,OName,multi);
 
   return;
 }
@@ -0,0 +1,87 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geomInc/BBox.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef Geometry_BBox_h
+#define Geometry_BBox_h
+
+namespace Geometry
+{
+
+/*!
+  \class BBox
+  \brief Axis aligned bounding box
+  \author S. Ansell
+  \date October 2026
+  \version 1.0
+
+  Conservative axis aligned box. Unbounded directions
+  are held as +/- infinity. A default box is all space,
+  an empty box has lowPt > highPt.
+*/
+
+class BBox
+{
+ private:
+
+  Geometry::Vec3D lowPt;        ///< Low corner
+  Geometry::Vec3D highPt;       ///< High corner
+
+ public:
+
+  static BBox emptyBox();
+
+  BBox();
+  BBox(const Geometry::Vec3D&,const Geometry::Vec3D&);
+  BBox(const BBox&);
+  BBox& operator=(const BBox&);
+  ~BBox();
+
+  BBox& operator*=(const BBox&);
+  BBox& operator+=(const BBox&);
+  BBox operator*(const BBox&) const;
+  BBox operator+(const BBox&) const;
+
+  /// Access low corner
+  const Geometry::Vec3D& getLow() const { return lowPt; }
+  /// Access high corner
+  const Geometry::Vec3D& getHigh() const { return highPt; }
+
+  bool isEmpty() const;
+  bool isInfinite() const;
+  bool isValid(const Geometry::Vec3D&) const;
+  bool intersects(const BBox&) const;
+
+  void setAxisRange(const size_t,const double,const double);
+  void addPoint(const Geometry::Vec3D&);
+  void grow(const double);
+
+  Geometry::Vec3D getCentre() const;
+  size_t longestAxis() const;
+  double volume() const;
+
+  void write(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&,const BBox&);
+
+}  // NAMESPACE Geometry
+
+#endif
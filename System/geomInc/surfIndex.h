@@ -36,6 +36,11 @@ namespace ModelSupport
   \author S. Ansell
   \date December 2009
   \brief Storage for all the surfaces in the problem
+
+  The surfaces are also held in a hash index of their
+  canonical form (see surfEqual::surfHashKeys) to allow
+  fast equal/opposite lookup. Surfaces changed in place 
+  after insertion require resetHash.
 */
 
 class surfIndex
@@ -49,9 +54,20 @@ class surfIndex
   int uniqNum;                      ///< uniq number
   STYPE SMap;                    ///< Index of kept surfaces
   std::map<int,int> holdMap;     ///< Hold/Write map :: surfaceN : write/no-write flag
+
+  mutable bool hashValid;                      ///< Hash index valid
+  mutable std::multimap<size_t,int> hashMap;   ///< Hash key : surfaceN
+  mutable std::map<int,size_t> surfHash;       ///< surfaceN : Hash key
+  mutable std::vector<int> pendingHash;        ///< surfaceN to re-hash
   
   surfIndex();
 
+  void addHash(const int) const;
+  void removeHash(const int) const;
+  void updateHash() const;
+  std::vector<int> hashCandidates(const Geometry::Surface*,
+				  const bool) const;
+
   ////\cond SINGLETON
   surfIndex(const surfIndex&);
   surfIndex& operator=(const surfIndex&);
@@ -80,6 +96,7 @@ class surfIndex
   int checkSurface(const int,const Geometry::Vec3D&) const; 
   void deleteSurface(const int);
   void renumber(const int,const int);
+  void renumber(const std::map<int,int>&);
 
   Geometry::Surface* getSurf(const int) const;
   template<typename T> T* realSurf(const int) const; 
@@ -103,6 +120,8 @@ class surfIndex
 		    std::map<int,Geometry::Surface*>&) const;
   void removeOpposite(const int);
   int findOpposite(const Geometry::Surface*) const;
+  Geometry::Surface* findEqualSurface(const Geometry::Surface*) const;
+  void resetHash();
 
 };
 
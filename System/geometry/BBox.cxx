@@ -0,0 +1,342 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   geometry/BBox.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <limits>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "OutputLog.h"
+#include "Vec3D.h"
+#include "BBox.h"
+
+namespace Geometry
+{
+
+std::ostream&
+operator<<(std::ostream& OX,const BBox& A)
+  /*!
+    Standard output stream
+    \param OX :: Output stream
+    \param A :: BBox to write
+    \return Stream State
+   */
+{
+  A.write(OX);
+  return OX;
+}
+
+BBox
+BBox::emptyBox()
+  /*!
+    Create a box that contains nothing
+    [suitable for building up via addPoint/operator+=]
+    \return empty box
+  */
+{
+  const double inf=std::numeric_limits<double>::infinity();
+  return BBox(Geometry::Vec3D(inf,inf,inf),
+	      Geometry::Vec3D(-inf,-inf,-inf));
+}
+
+BBox::BBox() :
+  lowPt(-std::numeric_limits<double>::infinity(),
+	-std::numeric_limits<double>::infinity(),
+	-std::numeric_limits<double>::infinity()),
+  highPt(std::numeric_limits<double>::infinity(),
+	 std::numeric_limits<double>::infinity(),
+	 std::numeric_limits<double>::infinity())
+  /*!
+    Constructor : Box of all space
+  */
+{}
+
+BBox::BBox(const Geometry::Vec3D& LP,const Geometry::Vec3D& HP) :
+  lowPt(LP),highPt(HP)
+  /*!
+    Constructor from corners
+    \param LP :: Low corner
+    \param HP :: High corner
+  */
+{}
+
+BBox::BBox(const BBox& A) :
+  lowPt(A.lowPt),highPt(A.highPt)
+  /*!
+    Copy constructor
+    \param A :: BBox to copy
+  */
+{}
+
+BBox&
+BBox::operator=(const BBox& A)
+  /*!
+    Assignment operator
+    \param A :: BBox to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      lowPt=A.lowPt;
+      highPt=A.highPt;
+    }
+  return *this;
+}
+
+BBox::~BBox()
+  /*!
+    Destructor
+  */
+{}
+
+BBox&
+BBox::operator*=(const BBox& A)
+  /*!
+    Intersection of two boxes
+    \param A :: Box to intersect
+    \return *this
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::max(lowPt[i],A.lowPt[i]);
+      highPt[i]=std::min(highPt[i],A.highPt[i]);
+    }
+  return *this;
+}
+
+BBox&
+BBox::operator+=(const BBox& A)
+  /*!
+    Union of two boxes
+    \param A :: Box to join
+    \return *this
+  */
+{
+  if (A.isEmpty()) return *this;
+  if (isEmpty())
+    {
+      *this=A;
+      return *this;
+    }
+
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(lowPt[i],A.lowPt[i]);
+      highPt[i]=std::max(highPt[i],A.highPt[i]);
+    }
+  return *this;
+}
+
+BBox
+BBox::operator*(const BBox& A) const
+  /*!
+    Intersection of two boxes
+    \param A :: Box to intersect
+    \return this * A
+  */
+{
+  BBox Out(*this);
+  Out*=A;
+  return Out;
+}
+
+BBox
+BBox::operator+(const BBox& A) const
+  /*!
+    Union of two boxes
+    \param A :: Box to join
+    \return this + A
+  */
+{
+  BBox Out(*this);
+  Out+=A;
+  return Out;
+}
+
+bool
+BBox::isEmpty() const
+  /*!
+    Determine if the box contains no space
+    \return true if empty
+  */
+{
+  return (lowPt[0]>highPt[0] ||
+	  lowPt[1]>highPt[1] ||
+	  lowPt[2]>highPt[2]);
+}
+
+bool
+BBox::isInfinite() const
+  /*!
+    Determine if the box is unbounded in any direction
+    \return true if any side is unbounded
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (std::isinf(lowPt[i]) || std::isinf(highPt[i]))
+      return 1;
+  return 0;
+}
+
+bool
+BBox::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if a point is within (or on) the box
+    \param Pt :: Point to test
+    \return true if within
+  */
+{
+  return (Pt[0]>=lowPt[0] && Pt[0]<=highPt[0] &&
+	  Pt[1]>=lowPt[1] && Pt[1]<=highPt[1] &&
+	  Pt[2]>=lowPt[2] && Pt[2]<=highPt[2]);
+}
+
+bool
+BBox::intersects(const BBox& A) const
+  /*!
+    Determine if two boxes overlap
+    \param A :: Box to test
+    \return true if there is a common region
+  */
+{
+  for(size_t i=0;i<3;i++)
+    if (A.highPt[i]<lowPt[i] || A.lowPt[i]>highPt[i])
+      return 0;
+  return 1;
+}
+
+void
+BBox::setAxisRange(const size_t index,
+		   const double LV,const double HV)
+  /*!
+    Restrict the range along an axis
+    \param index :: axis index [0-2]
+    \param LV :: low value
+    \param HV :: high value
+  */
+{
+  if (index>2)
+    throw ColErr::IndexError<size_t>(index,3,"index");
+
+  lowPt[index]=std::max(lowPt[index],LV);
+  highPt[index]=std::min(highPt[index],HV);
+  return;
+}
+
+void
+BBox::addPoint(const Geometry::Vec3D& Pt)
+  /*!
+    Expand the box to include the point
+    \param Pt :: Point to add
+  */
+{
+  for(size_t i=0;i<3;i++)
+    {
+      lowPt[i]=std::min(lowPt[i],Pt[i]);
+      highPt[i]=std::max(highPt[i],Pt[i]);
+    }
+  return;
+}
+
+void
+BBox::grow(const double D)
+  /*!
+    Expand the box by a fixed distance on all sides
+    \param D :: distance to expand
+  */
+{
+  if (!isEmpty())
+    {
+      lowPt-=Geometry::Vec3D(D,D,D);
+      highPt+=Geometry::Vec3D(D,D,D);
+    }
+  return;
+}
+
+Geometry::Vec3D
+BBox::getCentre() const
+  /*!
+    Calculate the centre of the box. Unbounded directions
+    are set to zero
+    \return centre point
+  */
+{
+  Geometry::Vec3D Out;
+  for(size_t i=0;i<3;i++)
+    if (!std::isinf(lowPt[i]) && !std::isinf(highPt[i]))
+      Out[i]=(lowPt[i]+highPt[i])/2.0;
+  return Out;
+}
+
+size_t
+BBox::longestAxis() const
+  /*!
+    Get the index of the longest side
+    \return index [0-2]
+  */
+{
+  size_t index(0);
+  double maxLen(highPt[0]-lowPt[0]);
+  for(size_t i=1;i<3;i++)
+    {
+      const double L=highPt[i]-lowPt[i];
+      if (L>maxLen)
+	{
+	  maxLen=L;
+	  index=i;
+	}
+    }
+  return index;
+}
+
+double
+BBox::volume() const
+  /*!
+    Calculate the volume
+    \return volume [0 if empty]
+  */
+{
+  if (isEmpty()) return 0.0;
+  return (highPt-lowPt).volume();
+}
+
+void
+BBox::write(std::ostream& OX) const
+  /*!
+    Write out the box
+    \param OX :: Output stream
+  */
+{
+  OX<<"["<<lowPt<<" : "<<highPt<<"]";
+  return;
+}
+
+} // NAMESPACE Geometry
@@ -57,7 +57,8 @@
 namespace ModelSupport
 {
 
-surfIndex::surfIndex() : uniqNum(1)
+surfIndex::surfIndex() :
+  uniqNum(1),hashValid(1)
   /*!
     Constructor
   */
@@ -94,9 +95,135 @@ surfIndex::reset()
   for(mc=SMap.begin();mc!=SMap.end();mc++)
     delete mc->second;
   SMap.erase(SMap.begin(),SMap.end());
+
+  hashMap.clear();
+  surfHash.clear();
+  pendingHash.clear();
+  hashValid=1;
+  return;
+}
+
+void
+surfIndex::resetHash()
+  /*!
+    Force a rebuild of the hash index [e.g. surfaces moved]
+  */
+{
+  hashValid=0;
+  return;
+}
+
+void
+surfIndex::addHash(const int SN) const
+  /*!
+    Add a surface to the hash index
+    \param SN :: Surface number [must be in SMap]
+  */
+{
+  STYPE::const_iterator mc=SMap.find(SN);
+  if (mc!=SMap.end())
+    {
+      const size_t key=
+	ModelSupport::surfHashKeys(mc->second,0).front();
+      hashMap.emplace(key,SN);
+      surfHash[SN]=key;
+    }
   return;
 }
 
+void
+surfIndex::removeHash(const int SN) const
+  /*!
+    Remove a surface from the hash index
+    \param SN :: Surface number
+  */
+{
+  std::map<int,size_t>::iterator mc=surfHash.find(SN);
+  if (mc!=surfHash.end())
+    {
+      typedef std::multimap<size_t,int>::iterator HITER;
+      const std::pair<HITER,HITER> Range=hashMap.equal_range(mc->second);
+      for(HITER hc=Range.first;hc!=Range.second;hc++)
+	if (hc->second==SN)
+	  {
+	    hashMap.erase(hc);
+	    break;
+	  }
+      surfHash.erase(mc);
+    }
+  return;
+}
+
+void
+surfIndex::updateHash() const
+  /*!
+    Bring the hash index up to date with SMap
+  */
+{
+  if (!hashValid)
+    {
+      hashMap.clear();
+      surfHash.clear();
+      pendingHash.clear();
+      for(const STYPE::value_type& SItem : SMap)
+	addHash(SItem.first);
+      hashValid=1;
+    }
+  else if (!pendingHash.empty())
+    {
+      for(const int SN : pendingHash)
+	{
+	  removeHash(SN);
+	  addHash(SN);
+	}
+      pendingHash.clear();
+    }
+  return;
+}
+
+std::vector<int>
+surfIndex::hashCandidates(const Geometry::Surface* SPtr,
+			  const bool oppFlag) const
+  /*!
+    Get the surfaces in the hash buckets that could match SPtr
+    \param SPtr :: Surface to test
+    \param oppFlag :: Look for the opposite surface
+    \return surface numbers [ordered]
+  */
+{
+  updateHash();
+  
+  std::vector<int> Out;
+  for(const size_t key : ModelSupport::surfHashKeys(SPtr,oppFlag))
+    {
+      typedef std::multimap<size_t,int>::const_iterator HITER;
+      const std::pair<HITER,HITER> Range=hashMap.equal_range(key);
+      for(HITER hc=Range.first;hc!=Range.second;hc++)
+	Out.push_back(hc->second);
+    }
+  std::sort(Out.begin(),Out.end());
+  Out.erase(std::unique(Out.begin(),Out.end()),Out.end());
+  return Out;
+}
+
+Geometry::Surface*
+surfIndex::findEqualSurface(const Geometry::Surface* SPtr) const
+  /*!
+    Find the lowest numbered surface equal to SPtr
+    \param SPtr :: Surface to test
+    \return Surface / 0 if no match
+  */
+{
+  for(const int SN : hashCandidates(SPtr,0))
+    {
+      STYPE::const_iterator mc=SMap.find(SN);
+      if (mc!=SMap.end() &&
+	  ModelSupport::cmpSurfaces(SPtr,mc->second))
+	return mc->second;
+    }
+  return 0;
+}
+
 int
 surfIndex::getUniq() 
   /*!
@@ -132,7 +259,10 @@ surfIndex::addSurface(Geometry::Surface* SPtr)
   Geometry::Surface* NewPtr=ModelSupport::equalSurface(SPtr);
   // Now find if we have copy
   if (NewPtr==SPtr)
-    SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+    {
+      SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+      addHash(SPtr->getName());
+    }
   else
     delete SPtr;
 
@@ -173,6 +303,7 @@ surfIndex::insertSurface(Geometry::Surface* SPtr)
     }
 
   SMap.insert(STYPE::value_type(SPtr->getName(),SPtr));
+  addHash(SPtr->getName());
 
   return;
 }
@@ -190,10 +321,13 @@ surfIndex::findOpposite(const Geometry::Surface* SPtr)  const
     dynamic_cast<const Geometry::Plane*>(SPtr);
   if (PPtr)
     {
-      STYPE::const_iterator mc;
-      for(mc=SMap.begin();mc!=SMap.end();mc++)
-	if (ModelSupport::oppositeSurfaces(PPtr,mc->second)) 
-	  return mc->first;
+      for(const int SN : hashCandidates(PPtr,1))
+	{
+	  STYPE::const_iterator mc=SMap.find(SN);
+	  if (mc!=SMap.end() &&
+	      ModelSupport::oppositeSurfaces(PPtr,mc->second)) 
+	    return mc->first;
+	}
     }
   return 0;
 }
@@ -210,6 +344,7 @@ surfIndex::removeOpposite(const int SN)
   STYPE::iterator sc=SMap.find(SN);
   if (sc!=SMap.end())
     {
+      removeHash(SN);
       delete sc->second;
       SMap.erase(sc);
     }
@@ -236,6 +371,7 @@ surfIndex::removeEqualSurface(const int SNum)
   
   if (NewPtr!=vc->second)
     {
+      removeHash(SNum);
       delete vc->second;
       SMap.erase(vc);
     }
@@ -273,6 +409,8 @@ surfIndex::createSurf(const int surfN)
   STYPE::iterator mp=SMap.find(surfN);
   if (mp!=SMap.end())
     {
+      // surface is set after return:
+      pendingHash.push_back(surfN);
       outPtr=dynamic_cast<T*>(mp->second);
       if (outPtr)
 	return outPtr;
@@ -284,6 +422,7 @@ surfIndex::createSurf(const int surfN)
     }
   outPtr=new T(surfN);
   SMap.insert(STYPE::value_type(surfN,outPtr));
+  pendingHash.push_back(surfN);
   return outPtr;
 }
 
@@ -345,6 +484,7 @@ surfIndex::createSurface(const int SN,const std::string& SLine)
   if (mc!=SMap.end())
     throw ColErr::InContainerError<int>(SN,"Surface in use");
   SMap.emplace(SN,SPtr);
+  addHash(SN);
   return; 
 }
 
@@ -361,6 +501,7 @@ surfIndex::deleteSurface(const int surfN)
   if (mf==SMap.end())
     throw ColErr::InContainerError<int>(surfN,"surfN");
 
+  removeHash(surfN);
   delete mf->second;
   SMap.erase(mf);
 
@@ -425,12 +566,44 @@ surfIndex::renumber(const int origNum,const int newNum)
       return;
     }
   Geometry::Surface* SPtr=mc->second;
+  removeHash(origNum);
   SMap.erase(mc);
   SPtr->setName(newNum);
   insertSurface(SPtr);
   return;
 }
 
+void 
+surfIndex::renumber(const std::map<int,int>& RMap)
+  /*!
+    Convert all the surfaces in the map to the new numbers.
+    All the surfaces are removed before any are re-inserted
+    so a new number can be the old number of a later surface.
+    \param RMap :: map of original number : new number
+  */
+{
+  ELog::RegMethod RegA("surfIndex","renumber(map)");
+
+  std::vector<Geometry::Surface*> moved;
+  for(const auto& [origNum,newNum] : RMap)
+    {
+      STYPE::iterator mc=SMap.find(origNum);
+      if (mc==SMap.end())
+	{
+	  ELog::EM<<"Surface "<<origNum<<" does not exist"<<ELog::endWarn;
+	  continue;
+	}
+      Geometry::Surface* SPtr=mc->second;
+      removeHash(origNum);
+      SMap.erase(mc);
+      SPtr->setName(newNum);
+      moved.push_back(SPtr);
+    }
+  for(Geometry::Surface* SPtr : moved)
+    insertSurface(SPtr);
+  return;
+}
+
 int
 surfIndex::calcRenumber(const int allowedSurf,
 			std::vector<std::pair<int,int> >& ChangeList) const
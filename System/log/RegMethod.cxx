@@ -32,7 +32,7 @@
 namespace ELog
 {
 
-NameStack RegMethod::Base;
+thread_local NameStack RegMethod::Base;
 
 RegMethod::RegMethod(const std::string& CN,
 		     const std::string& MN) :
@@ -39,7 +39,7 @@ class RegMethod
 {
  private:
 
-  static NameStack Base;           ///< Singleton of base to register
+  static thread_local NameStack Base;   ///< Per-thread base to register
 
   int indentLevel;                 ///< Additional indent
   /// \cond NOWRITTEN
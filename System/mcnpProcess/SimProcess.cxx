@@ -149,6 +149,105 @@ writeIndexSimPHITS(SimPHITS& System,const std::string& FName,
   return;
 }
 
+void
+writeMultiSim(SimMCNP& System,const std::string& OName,
+	      const int multi)
+  /*!
+    Writes out multi files, each with a new random number.
+    The files and seeds are the same as calling writeIndexSim
+    for each index but the common blocks are only built once.
+    \param System :: Simuation object 
+    \param OName :: basic filename
+    \param multi :: number of files to write [min 1]
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSim");
+  
+  physicsSystem::PhysicsCards& PC=System.getPC();
+  System.prepareWrite();
+  System.makeObjectsDNForCNF();
+
+  std::vector<std::string> FNames;
+  std::vector<long int> RNDseed;
+  long int seed(PC.getRNDseed());
+  int index(0);
+  do
+    {
+      // increase the RND seed by N*10 [10,20,40,etc]
+      seed+=index*10;
+      RNDseed.push_back(seed);
+      FNames.push_back(OName+std::to_string(index+1)+".x");
+      index++;
+    }
+  while(index<multi);
+
+  System.writeMulti(FNames,RNDseed);
+  return;
+}
+
+void
+writeMultiSimFLUKA(SimFLUKA& System,const std::string& OName,
+		   const int multi)
+  /*!
+    Writes out multi files, each with a new random number.
+    The files and seeds are the same as calling
+    writeIndexSimFLUKA for each index.
+    \param System :: Simuation object 
+    \param OName :: basic filename
+    \param multi :: number of files to write [min 1]
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSimFLUKA");
+
+  System.prepareWrite();
+
+  std::vector<std::string> FNames;
+  std::vector<long int> RNDseed;
+  long int seed(System.getRNDseed());
+  int index(0);
+  do
+    {
+      seed+=index*11;
+      RNDseed.push_back(seed);
+      FNames.push_back(OName+std::to_string(index+1)+".inp");
+      index++;
+    }
+  while(index<multi);
+
+  System.writeMulti(FNames,RNDseed);
+  return;
+}
+
+void
+writeMultiSimPHITS(SimPHITS& System,const std::string& FName,
+		   const int multi)
+  /*!
+    Writes out multi files, each with its own tally file name.
+    The files are the same as calling writeIndexSimPHITS
+    for each index.
+    \param System :: Simuation object 
+    \param FName :: basic filename
+    \param multi :: number of files to write [min 1]
+  */
+{
+  ELog::RegMethod RegA("SimProcess[F]","writeMultiSimPHITS");
+
+  std::vector<std::string> FNames;
+  std::vector<std::string> TNames;
+  int index(0);
+  do
+    {
+      const std::string fileName=FName+std::to_string(index+1);
+      TNames.push_back(fileName);
+      FNames.push_back(fileName+".phs");
+      index++;
+    }
+  while(index<multi);
+
+  System.writeMulti(FNames,TNames);
+  return;
+}
+
 void
 registerOuter(Simulation& System,const int cellNum,const int vNum)
   /*!
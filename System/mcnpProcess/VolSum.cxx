@@ -34,7 +34,10 @@
 #include <utility>
 #include <vector>
 #include <format>
+#include <algorithm>
+#include <functional>
 
+#include "Exception.h"
 #include "FileReport.h"
 #include "NameStack.h"
 #include "RegMethod.h"
@@ -60,6 +63,8 @@
 #include "SimMCNP.h"
 #include "LineUnit.h"
 #include "LineTrack.h"
+#include "SimTrack.h"
+#include "threadSupport.h"
 #include "volUnit.h"
 #include "VolSum.h"
 
@@ -82,7 +87,8 @@ VolSum::VolSum(const VolSum& A) :
   Origin(A.Origin),X(A.X),Y(A.Y),Z(A.Z),
   fracX(A.fracX),fracY(A.fracY),
   fullVol(A.fullVol),totalDist(A.totalDist),
-  nTracks(A.nTracks),tallyVols(A.tallyVols)
+  nTracks(A.nTracks),tallyVols(A.tallyVols),
+  adaptVols(A.adaptVols)
   /*!
     Copy constructor
     \param A :: VolSum to copy
@@ -107,6 +113,7 @@ VolSum::operator=(const VolSum& A)
       totalDist=A.totalDist;
       nTracks=A.nTracks;
       tallyVols=A.tallyVols;
+      adaptVols=A.adaptVols;
     }
   return *this;
 }
@@ -279,6 +286,7 @@ VolSum::reset()
   std::map<int,volUnit>::iterator mc;
   for(mc=tallyVols.begin();mc!=tallyVols.end();mc++)
     mc->second.reset();
+  adaptVols.clear();
   nTracks=0;
   totalDist=0.0;
   return;
@@ -396,6 +404,146 @@ VolSum::trackRun(const Simulation& System,const size_t N)
   return;
 }
 
+void
+VolSum::adaptiveRun(const Simulation& System,
+		    const double targetErr,
+		    const size_t nStrata,
+		    const size_t NMax) 
+  /*!
+    Chord length estimate of the volumes. Each batch has one
+    track along the longest axis of the box through each of
+    nStrata x nStrata strata of the opposite face. Each batch is an 
+    independent estimate of the volume, and a tally is frozen
+    once the relative error of its mean is below targetErr.
+    The tracks of a batch are split over System.getThreads()
+    threads. Each track has its own seeded generator, and the 
+    sums are serial, so the result does not depend on the thread count.
+    The strata are reduced if minBatch batches would exceed NMax,
+    so that no more than NMax tracks are used.
+    \param System :: Simulation to use
+    \param targetErr :: Target relative error
+    \param nStrata :: Strata on each side of the face
+    \param NMax :: Max number of tracks
+  */
+{
+  ELog::RegMethod RegA("VolSum","adaptiveRun");
+
+  if (!nStrata)
+    throw ColErr::RangeError<size_t>(nStrata,1,1000,"nStrata");
+  if (!NMax)
+    throw ColErr::EmptyValue<size_t>("NMax");
+  
+  const size_t minBatch(4);
+
+  size_t nSide(nStrata);
+  while(nSide>1 && minBatch*nSide*nSide>NMax)
+    nSide--;
+  if (nSide!=nStrata)
+    ELog::EM<<"Strata reduced to "<<nSide<<" for "
+	    <<NMax<<" tracks"<<ELog::endWarn;
+  
+  reset();
+  fullVol=X.abs()*Y.abs()*Z.abs();
+
+  // tracks along L : sampled over U-V face
+  const Geometry::Vec3D* AxisPtr[3]={&X,&Y,&Z};
+  size_t longIndex(0);
+  for(size_t i=1;i<3;i++)
+    if (AxisPtr[i]->abs()>AxisPtr[longIndex]->abs())
+      longIndex=i;
+  const Geometry::Vec3D& L(*AxisPtr[longIndex]);
+  const Geometry::Vec3D& U(*AxisPtr[(longIndex+1) % 3]);
+  const Geometry::Vec3D& V(*AxisPtr[(longIndex+2) % 3]);
+  const double faceArea(U.abs()*V.abs());
+
+  const size_t NS(nSide*nSide);
+  const size_t maxBatch(NMax/NS);
+  const double NSdiv(static_cast<double>(nSide));
+
+  const size_t NT(tallyVols.size());
+  std::vector<double> sumV(NT,0.0);
+  std::vector<double> sumVV(NT,0.0);
+  std::vector<size_t> nBatch(NT,0);
+  std::vector<int> doneFlag(NT,0);
+
+  auto relError=[&](const size_t ti) -> double
+    {
+      const double N(static_cast<double>(nBatch[ti]));
+      const double mean(sumV[ti]/N);
+      if (nBatch[ti]<2 || mean<=0.0) return 1.0;
+      const double var=std::max(0.0,(sumVV[ti]-N*mean*mean)/(N-1.0));
+      return std::sqrt(var/N)/mean;
+    };
+
+  // object name : distance for each track of the batch
+  std::vector<std::vector<std::pair<int,double>>> trackSeg(NS);
+  size_t nDone(0);
+  size_t batch(0);
+  for(;batch<maxBatch && nDone<NT;batch++)
+    {
+      threadSupport::parallelLoop
+	(System.getThreads(),NS,
+	 [&](const size_t index)
+	 {
+	   std::mt19937 gen(static_cast<std::mt19937::result_type>
+			    (batch*NS+index+1));
+	   std::uniform_real_distribution<double> RNG(0.0,1.0);
+	   const double a=
+	     (static_cast<double>(index/nSide)+RNG(gen))/NSdiv;
+	   const double b=
+	     (static_cast<double>(index % nSide)+RNG(gen))/NSdiv;
+	   const Geometry::Vec3D APt=Origin+U*(a-0.5)+V*(b-0.5)-L*0.5;
+
+	   ModelSupport::SimTrack::Instance().setCell(&System,0);
+	   LineTrack A(APt,APt+L);
+	   A.calculate(System);
+	   std::vector<std::pair<int,double>>& Seg=trackSeg[index];
+	   Seg.clear();
+	   for(const ModelSupport::LineUnit& lu : A.getTrackPts())
+	     if (lu.objPtr)
+	       Seg.emplace_back(lu.objPtr->getName(),lu.segmentLength);
+	 });
+
+      for(const std::vector<std::pair<int,double>>& Seg : trackSeg)
+	for(const auto& [CN,D] : Seg)
+	  addDistance(CN,D);
+      
+      size_t ti(0);
+      for(auto& [TN,VUnit] : tallyVols)
+	{
+	  if (!doneFlag[ti])
+	    {
+	      const double VB=
+		faceArea*VUnit.calcVol(1.0)/static_cast<double>(NS);
+	      sumV[ti]+=VB;
+	      sumVV[ti]+=VB*VB;
+	      nBatch[ti]++;
+	      if (nBatch[ti]>=minBatch && relError(ti)<targetErr)
+		{
+		  doneFlag[ti]=1;
+		  nDone++;
+		}
+	    }
+	  VUnit.reset();
+	  ti++;
+	}
+    }
+
+  size_t ti(0);
+  for(const tvTYPE::value_type& TV : tallyVols)
+    {
+      const double mean=(nBatch[ti]) ?
+	sumV[ti]/static_cast<double>(nBatch[ti]) : 0.0;
+      adaptVols.emplace(TV.first,
+			std::pair<double,double>(mean,relError(ti)));
+      ti++;
+    }
+  nTracks=batch*NS;
+  ELog::EM<<"Volume tracks == "<<nTracks<<" : converged "
+	  <<nDone<<"/"<<NT<<ELog::endDiag;
+  return;
+}
+
 double
 VolSum::calcVolume(const int TN) const
   /*!
@@ -406,6 +554,11 @@ VolSum::calcVolume(const int TN) const
 {
   ELog::RegMethod RegA("VolSum","calcVolume");
 
+  std::map<int,std::pair<double,double>>::const_iterator ac=
+    adaptVols.find(TN);
+  if (ac!=adaptVols.end())
+    return ac->second.first;
+  
   if (nTracks<1) return 0.0;
   std::map<int,volUnit>::const_iterator mc;
   mc=tallyVols.find(TN);
@@ -427,21 +580,42 @@ VolSum::write(const std::string& OFile) const
   
   std::ofstream OX(OFile.c_str());
   
-  OX<<"FluxName   Volume(cc)  Sf Matrl  Description"<<std::endl;
-  OX<<"========  ============ == ====== "
-    <<"================================================ "<<std::endl;
-
+  const bool errFlag(!adaptVols.empty());
+  if (errFlag)
+    {
+      OX<<"FluxName   Volume(cc)   RelErr   Sf Matrl  Description"
+	<<std::endl;
+      OX<<"========  ============ ======== == ====== "
+	<<"================================================ "<<std::endl;
+    }
+  else
+    {
+      OX<<"FluxName   Volume(cc)  Sf Matrl  Description"<<std::endl;
+      OX<<"========  ============ == ====== "
+	<<"================================================ "<<std::endl;
+    }
+  
   char sf='a';  
   tvTYPE::const_iterator mc;
   const double nT((nTracks) ? static_cast<double>(nTracks) : 1.0);
   for(mc=tallyVols.begin();mc!=tallyVols.end();mc++)
     {
-      OX<<"tally"<<std::format("{:3d}  {:11.5e} {:c}  mat{:3d} {}",
-			       mc->first,
-			       (fullVol*mc->second.calcVol(1.0/nT)),
-			       sf,mc->second.getMat(),
-			       mc->second.getComment())
-	<<std::endl;
+      if (errFlag)
+	{
+	  const std::pair<double,double>& VE=adaptVols.at(mc->first);
+	  OX<<"tally"<<std::format("{:3d}  {:11.5e} {:8.2e} {:c}  mat{:3d} {}",
+				   mc->first,VE.first,VE.second,
+				   sf,mc->second.getMat(),
+				   mc->second.getComment())
+	    <<std::endl;
+	}
+      else
+	OX<<"tally"<<std::format("{:3d}  {:11.5e} {:c}  mat{:3d} {}",
+				 mc->first,
+				 (fullVol*mc->second.calcVol(1.0/nT)),
+				 sf,mc->second.getMat(),
+				 mc->second.getComment())
+	  <<std::endl;
       sf++;
     }
   OX.close();
@@ -43,6 +43,9 @@
 #include "varList.h"
 #include "Code.h"
 #include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Importance.h"
+#include "Object.h"
 #include "Triple.h"
 #include "NList.h"
 #include "NRange.h"
@@ -52,7 +55,6 @@
 #include "SimMCNP.h"
 #include "Tally.h"
 #include "pointTally.h"
-#include "vertexCalc.h"
 #include "LineUnit.h"
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
@@ -109,9 +111,7 @@ pointDetOpt::createObjAct(const Simulation& ASim)
   const Simulation::OTYPE& Cells=ASim.getCells();
   for(const auto& [cellNum,objPtr] : Cells)
     {
-      const Geometry::Vec3D CofM=
-	ModelSupport::calcCOFM(*objPtr);
-      OA.addUnit(ASim,cellNum,CofM);
+      OA.addUnit(ASim,cellNum,objPtr->getCofM());
     }
   return;
 }
@@ -43,6 +43,9 @@ namespace SimProcess
   void writeIndexSim(SimMCNP&,const std::string&,const int);
   void writeIndexSimPHITS(SimPHITS&,const std::string&,const int);
   void writeIndexSimFLUKA(SimFLUKA&,const std::string&,const int);
+  void writeMultiSim(SimMCNP&,const std::string&,const int);
+  void writeMultiSimPHITS(SimPHITS&,const std::string&,const int);
+  void writeMultiSimFLUKA(SimFLUKA&,const std::string&,const int);
 
   template<typename T,typename U>
   T getDefIndexVar(const FuncDataBase&,const std::string&,
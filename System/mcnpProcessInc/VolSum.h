@@ -59,6 +59,8 @@ class VolSum
   size_t nTracks;                           ///< Number of full tracks
    
   tvTYPE tallyVols;                         ///< TallyNum:Volumes
+  /// TallyNum:(Volume,RelErr) [adaptive run]
+  std::map<int,std::pair<double,double>> adaptVols;
 
   Geometry::Vec3D getCubePoint() const;
   
@@ -79,6 +81,8 @@ class VolSum
 
   void trackRun(const Simulation&,const size_t);
   void pointRun(const Simulation&,const size_t);
+  void adaptiveRun(const Simulation&,const double,
+		   const size_t,const size_t);
   double calcVolume(const int) const;
   void populateTally(const SimMCNP&);
   void populateAll(const Simulation&);
@@ -0,0 +1,242 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   modelSupport/AttnTable.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "AttnTable.h"
+
+namespace ModelSupport
+{
+
+const double AttnTable::EMin(1e-11);
+const double AttnTable::EMax(1e4);
+const size_t AttnTable::nPerDecade(10);
+
+AttnTable::AttnTable() :
+  energyScale(0),NGroup(0)
+  /*!
+    Constructor
+  */
+{}
+
+AttnTable&
+AttnTable::Instance()
+  /*!
+    Singleton this
+    \return AttnTable object
+   */
+{
+  static AttnTable AT;
+  return AT;
+}
+
+double
+AttnTable::energyFactor(const double E) const
+  /*!
+    Energy scaling of the geometric cross section :
+    adds a 1/v term that is unity at thermal energy
+    \param E :: Energy [MeV]
+    \return scale factor [>=1 / 1 if not energyScale]
+  */
+{
+  if (!energyScale) return 1.0;
+  const double ETherm(2.53e-8);
+  return (E>EMin) ? 1.0+std::sqrt(ETherm/E) : 1.0+std::sqrt(ETherm/EMin);
+}
+
+double
+AttnTable::calcAttn(const MonteCarlo::Material& MObj,const double E) const
+  /*!
+    Calculate the attenuation factor of a material directly
+    \param MObj :: Material
+    \param E :: Energy [MeV]
+    \return density * A^0.66 * energyFactor
+  */
+{
+  if (MObj.isVoid()) return 0.0;
+  return MObj.getAtomDensity()*std::pow(MObj.getMeanA(),0.66)*
+    energyFactor(E);
+}
+
+void
+AttnTable::clear()
+  /*!
+    Remove the table
+  */
+{
+  NGroup=0;
+  matIndex.clear();
+  matData.clear();
+  attnData.clear();
+  return;
+}
+
+void
+AttnTable::build()
+  /*!
+    Build the table from all the materials in DBMaterial.
+    Each group uses the geometric centre energy.
+    Must not be called while tracking threads are active.
+  */
+{
+  ELog::RegMethod RegA("AttnTable","build");
+
+  const ModelSupport::DBMaterial& DB=
+    ModelSupport::DBMaterial::Instance();
+
+  clear();
+  NGroup=(energyScale) ? static_cast<size_t>
+    (std::round(std::log10(EMax/EMin)*static_cast<double>(nPerDecade))) : 1;
+
+  std::vector<double> EMid(NGroup);
+  for(size_t g=0;g<NGroup;g++)
+    EMid[g]=EMin*std::pow(10.0,(static_cast<double>(g)+0.5)/
+			  static_cast<double>(nPerDecade));
+
+  int maxID(-1);
+  for(const auto& [matID,MPtr] : DB.getStore())
+    if (MPtr && matID>maxID) maxID=matID;
+  if (maxID<0) return;
+
+  matIndex.resize(static_cast<size_t>(maxID)+1,-1);
+  for(const auto& [matID,MPtr] : DB.getStore())
+    {
+      if (MPtr && matID>=0)
+	{
+	  matIndex[static_cast<size_t>(matID)]=
+	    static_cast<long int>(matData.size()/2);
+	  const double powA=(MPtr->isVoid()) ? 0.0 :
+	    std::pow(MPtr->getMeanA(),0.66);
+	  const double density=(MPtr->isVoid()) ? 0.0 :
+	    MPtr->getAtomDensity();
+	  matData.push_back(powA);
+	  matData.push_back(density);
+	  for(size_t g=0;g<NGroup;g++)
+	    attnData.push_back(density*powA*energyFactor(EMid[g]));
+	}
+    }
+  ELog::EM<<"Attenuation table : "<<getNMaterial()<<" materials "
+	  <<NGroup<<" groups"<<ELog::endDiag;
+  return;
+}
+
+size_t
+AttnTable::getGroup(const double E) const
+  /*!
+    Get the group index of an energy [clamped to the table]
+    \param E :: Energy [MeV]
+    \return group index [0 if not energyScale]
+  */
+{
+  if (E<=EMin || NGroup<=1) return 0;
+  const double G=std::log10(E/EMin)*static_cast<double>(nPerDecade);
+  return (G<static_cast<double>(NGroup)) ?
+    static_cast<size_t>(G) : NGroup-1;
+}
+
+const double*
+AttnTable::getMatData(const MonteCarlo::Material& MObj) const
+  /*!
+    Get the energy independent values for a material
+    \param MObj :: Material
+    \return pointer to [A^0.66,density] / 0 if not in table
+  */
+{
+  const int matID=MObj.getID();
+  if (matID<0 || static_cast<size_t>(matID)>=matIndex.size())
+    return 0;
+  const long int row=matIndex[static_cast<size_t>(matID)];
+  return (row<0) ? 0 : matData.data()+2*static_cast<size_t>(row);
+}
+
+const double*
+AttnTable::getRow(const MonteCarlo::Material& MObj) const
+  /*!
+    Get the group values for a material
+    \param MObj :: Material
+    \return pointer to NGroup values / 0 if not in table
+  */
+{
+  const int matID=MObj.getID();
+  if (matID<0 || static_cast<size_t>(matID)>=matIndex.size())
+    return 0;
+  const long int row=matIndex[static_cast<size_t>(matID)];
+  return (row<0) ? 0 : 
+    attnData.data()+static_cast<size_t>(row)*NGroup;
+}
+
+double
+AttnTable::getAttn(const MonteCarlo::Material& MObj,
+		   const double E) const
+  /*!
+    Get the attenuation factor of a material
+    \param MObj :: Material
+    \param E :: Energy [MeV]
+    \return density * A^0.66 * energyFactor
+  */
+{
+  const double* RPtr=getRow(MObj);
+  return (RPtr) ? RPtr[getGroup(E)] : calcAttn(MObj,E);
+}
+
+double
+AttnTable::trackAttn(const MonteCarlo::Material& MObj,
+		     const double length,const double E,
+		     const size_t group) const
+  /*!
+    Get the attenuation of a track segment. Without energy
+    scaling this is length * A^0.66 * density [in that order]
+    \param MObj :: Material [non-void]
+    \param length :: Segment length
+    \param E :: Energy [MeV]
+    \param group :: getGroup(E) [found once per track]
+    \return attenuation of the segment
+  */
+{
+  if (!energyScale)
+    {
+      const double* DPtr=getMatData(MObj);
+      return (DPtr) ? length*DPtr[0]*DPtr[1] :
+	length*std::pow(MObj.getMeanA(),0.66)*MObj.getAtomDensity();
+    }
+  const double* RPtr=getRow(MObj);
+  return (RPtr) ? length*RPtr[group] : length*calcAttn(MObj,E);
+}
+  
+} // NAMESPACE ModelSupport
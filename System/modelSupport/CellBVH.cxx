@@ -0,0 +1,379 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   modelSupport/CellBVH.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <set> 
+#include <map> 
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <memory>
+#include <atomic>
+
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Vec3D.h"
+#include "BBox.h"
+#include "HeadRule.h"
+#include "Importance.h"
+#include "Object.h"
+#include "CellBVH.h"
+
+
+namespace ModelSupport
+{
+
+const size_t CellBVH::leafSize(4);
+
+std::ostream&
+operator<<(std::ostream& OX,const CellBVH& A)
+  /*!
+    Write the tree stats to a stream
+    \param OX :: Output stream
+    \param A :: CellBVH to write
+    \return Stream state
+  */
+{
+  A.write(OX);
+  return OX;
+}
+
+CellBVH::CellBVH() :
+  active(0),buildChange(0),nQuery(0),nTested(0)
+ /*! 
+   Constructor 
+ */
+{}
+
+CellBVH::CellBVH(const CellBVH& A) :
+  active(A.active),buildChange(A.buildChange),
+  Nodes(A.Nodes),ItemBox(A.ItemBox),
+  Items(A.Items),Unbound(A.Unbound),
+  nQuery(A.nQuery.load()),nTested(A.nTested.load())
+  /*! 
+    Copy Constructor 
+    \param A :: CellBVH to copy
+  */
+{}
+
+CellBVH&
+CellBVH::operator=(const CellBVH& A) 
+  /*! 
+    Assignment operator
+    \param A :: CellBVH to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      active=A.active;
+      buildChange=A.buildChange;
+      Nodes=A.Nodes;
+      ItemBox=A.ItemBox;
+      Items=A.Items;
+      Unbound=A.Unbound;
+      nQuery=A.nQuery.load();
+      nTested=A.nTested.load();
+    }
+  return *this;
+}
+
+void
+CellBVH::clearAll()
+  /*!
+    Remove the tree [counters are kept]
+  */
+{
+  active=0;
+  Nodes.clear();
+  ItemBox.clear();
+  Items.clear();
+  Unbound.clear();
+  return;
+}
+
+bool
+CellBVH::isBuilt() const
+  /*!
+    The tree is valid if it has been built and no
+    object in it has had its box cleared since
+    [HeadRule changed / surfaces moved].
+    \return true if the tree can be used
+  */
+{
+  return (active &&
+	  buildChange==MonteCarlo::Object::getBVHChange());
+}
+
+bool
+CellBVH::isStale() const
+  /*!
+    The tree has been built but an object in it
+    has since cleared its box.
+    \return true if the tree needs to be rebuilt
+  */
+{
+  return (active &&
+	  buildChange!=MonteCarlo::Object::getBVHChange());
+}
+
+void
+CellBVH::resetCount() const
+  /*!
+    Zero the query counters
+  */
+{
+  nQuery=0;
+  nTested=0;
+  return;
+}
+
+size_t
+CellBVH::buildNode(const size_t firstIndex,const size_t lastIndex)
+  /*!
+    Construct a node for items [firstIndex,lastIndex) and 
+    recursively split until the leaf size is reached.
+    \param firstIndex :: first item
+    \param lastIndex :: one past the last item
+    \return node index
+  */
+{
+  const size_t nodeIndex(Nodes.size());
+  Nodes.push_back(BVHNode());
+
+  Geometry::BBox Box(Geometry::BBox::emptyBox());
+  Geometry::BBox centreBox(Geometry::BBox::emptyBox());
+  for(size_t i=firstIndex;i<lastIndex;i++)
+    {
+      Box+=ItemBox[i];
+      centreBox.addPoint(ItemBox[i].getCentre());
+    }
+  Nodes[nodeIndex].Box=Box;
+  Nodes[nodeIndex].leftIndex=0;
+  Nodes[nodeIndex].rightIndex=0;
+  Nodes[nodeIndex].firstItem=firstIndex;
+  Nodes[nodeIndex].nItem=lastIndex-firstIndex;
+
+  if (lastIndex-firstIndex<=leafSize)
+    return nodeIndex;
+
+  // split about the median centre on the longest axis:
+  const size_t axis=centreBox.longestAxis();
+  if (centreBox.getHigh()[axis]-centreBox.getLow()[axis]<=0.0)
+    return nodeIndex;
+  
+  const size_t midIndex=(firstIndex+lastIndex)/2;
+
+  std::vector<size_t> Order(lastIndex-firstIndex);
+  std::iota(Order.begin(),Order.end(),firstIndex);
+  std::nth_element(Order.begin(),Order.begin()+
+		   static_cast<long int>(midIndex-firstIndex),Order.end(),
+		   [this,axis](const size_t A,const size_t B)
+		   {
+		     return ItemBox[A].getCentre()[axis]<
+		       ItemBox[B].getCentre()[axis];
+		   });
+
+  std::vector<Geometry::BBox> tmpBox;
+  std::vector<MonteCarlo::Object*> tmpItem;
+  for(const size_t index : Order)
+    {
+      tmpBox.push_back(ItemBox[index]);
+      tmpItem.push_back(Items[index]);
+    }
+  std::copy(tmpBox.begin(),tmpBox.end(),ItemBox.begin()+
+	    static_cast<long int>(firstIndex));
+  std::copy(tmpItem.begin(),tmpItem.end(),Items.begin()+
+	    static_cast<long int>(firstIndex));
+
+  const size_t leftIndex=buildNode(firstIndex,midIndex);
+  const size_t rightIndex=buildNode(midIndex,lastIndex);
+  // Note: Nodes may have reallocated
+  Nodes[nodeIndex].leftIndex=leftIndex;
+  Nodes[nodeIndex].rightIndex=rightIndex;
+  Nodes[nodeIndex].nItem=0;
+  
+  return nodeIndex;
+}
+
+void
+CellBVH::build(const std::map<int,MonteCarlo::Object*>& OList)
+  /*!
+    Build the tree from the objects. The objects
+    must have a surface list [createSurfaceList]. This
+    calculates any bounding box not yet cached.
+    \param OList :: Object map
+  */
+{
+  ELog::RegMethod RegA("CellBVH","build");
+
+  clearAll();
+  for(const auto& [cellN,OPtr] : OList)
+    {
+      const Geometry::BBox Box=OPtr->getBoundBox();
+      if (Box.isEmpty())
+	continue;          // no volume
+      if (Box.isInfinite())
+	Unbound.push_back(OPtr);
+      else
+	{
+	  ItemBox.push_back(Box);
+	  Items.push_back(OPtr);
+	  OPtr->setBVH(1);
+	}
+    }
+  if (!Items.empty())
+    buildNode(0,Items.size());
+  buildChange=MonteCarlo::Object::getBVHChange();
+  active=1;
+
+  ELog::EM<<"Cell BVH : "<<Items.size()<<" bound / "
+	  <<Unbound.size()<<" unbound cells"<<ELog::endDiag;
+  return;
+}
+
+void
+CellBVH::addObject(MonteCarlo::Object* OPtr)
+  /*!
+    Add an object after the tree has been built. It is 
+    held in the unbound list so that the tree is still valid
+    \param OPtr :: Object to add
+  */
+{
+  if (active && OPtr)
+    Unbound.push_back(OPtr);
+  return;
+}
+
+void
+CellBVH::removeObject(const MonteCarlo::Object* OPtr)
+  /*!
+    Remove an object from the tree. The tree boxes
+    are left as is [they remain conservative].
+    \param OPtr :: Object to remove
+  */
+{
+  if (!active || !OPtr) return;
+  
+  Unbound.erase(std::remove(Unbound.begin(),Unbound.end(),OPtr),
+		Unbound.end());
+  std::replace_if(Items.begin(),Items.end(),
+		  [OPtr](const MonteCarlo::Object* IPtr)
+		  { return IPtr==OPtr; },
+		  static_cast<MonteCarlo::Object*>(0));
+  return;
+}
+
+std::vector<MonteCarlo::Object*>
+CellBVH::findCandidates(const Geometry::Vec3D& Pt) const
+  /*!
+    Get the cells that might contain the point
+    \param Pt :: Point to test
+    \return Objects in cell number order
+  */
+{
+  std::vector<MonteCarlo::Object*> Out(Unbound);
+
+  if (!Nodes.empty())
+    {
+      std::vector<size_t> Stack({0});
+      while(!Stack.empty())
+	{
+	  const BVHNode& NRef=Nodes[Stack.back()];
+	  Stack.pop_back();
+	  if (NRef.Box.isValid(Pt))
+	    {
+	      if (NRef.nItem)
+		{
+		  for(size_t i=0;i<NRef.nItem;i++)
+		    if (Items[NRef.firstItem+i] &&
+			ItemBox[NRef.firstItem+i].isValid(Pt))
+		      Out.push_back(Items[NRef.firstItem+i]);
+		}
+	      else
+		{
+		  Stack.push_back(NRef.rightIndex);
+		  Stack.push_back(NRef.leftIndex);
+		}
+	    }
+	}
+    }
+  
+  std::sort(Out.begin(),Out.end(),
+	    [](const MonteCarlo::Object* A,const MonteCarlo::Object* B)
+	    {
+	      return A->getName()<B->getName();
+	    });
+  return Out;
+}
+
+MonteCarlo::Object*
+CellBVH::findCell(const Geometry::Vec3D& Pt,
+		  const MonteCarlo::Object* skipA,
+		  const MonteCarlo::Object* skipB) const
+  /*!
+    Find the lowest numbered cell that contains the point.
+    \param Pt :: Point to find
+    \param skipA :: Object already tested [can be null]
+    \param skipB :: Object already tested [can be null]
+    \return Object / 0 if not found
+  */
+{
+  nQuery++;
+  for(MonteCarlo::Object* OPtr : findCandidates(Pt))
+    {
+      if (OPtr!=skipA && OPtr!=skipB)
+	{
+	  nTested++;
+	  if (OPtr->isValid(Pt))
+	    return OPtr;
+	}
+    }
+  return 0;
+}
+
+void
+CellBVH::write(std::ostream& OX) const
+  /*!
+    Write out the tree statistics
+    \param OX :: Output stream
+  */
+{
+  OX<<"CellBVH : nodes="<<Nodes.size()
+    <<" bound="<<Items.size()
+    <<" unbound="<<Unbound.size()
+    <<" queries="<<nQuery.load()
+    <<" tested="<<nTested.load();
+  if (nQuery)
+    OX<<" ("<<static_cast<double>(nTested)/static_cast<double>(nQuery)
+      <<" per query)";
+  return;
+}
+
+} // NAMESPACE ModelSupport
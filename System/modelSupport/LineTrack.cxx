@@ -152,7 +152,8 @@ LineTrack::calculate(const Simulation& System,
   /*!
     Check the track (faster than calculate)
     \param System :: Simulation to use
-    \return error state
+    \param initCell :: Initial cell guess
+    \return error state [-1 if the track is lost]
   */
 {
   ELog::RegMethod RegA("LineTrack","calculate");
@@ -202,12 +203,9 @@ LineTrack::calculate(const Simulation& System,
 	{
 	  Org+=uVec*aDist;
 	  OPtr=OSMPtr->findNextObject(SN,Org,OPtr->getName());
+	  // no logging : this is called from tracking threads
 	  if (!OPtr)
-	    {
-	      ELog::EM<<"INIT POINT[error] == "<<InitPt<<ELog::endCrit;
-	      //	      calculateError(System);
-	      return -1;
-	    }
+	    return -1;
 	  // if (!OPtr || aDist<Geometry::zeroTol)
 	  //   OPtr=System.findCell(nOut.Pos,0);
 	}
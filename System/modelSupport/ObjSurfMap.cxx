@@ -309,6 +309,38 @@ ObjSurfMap::removeReverseSurf(const int primSurf,const int revSurf)
   return;
 }
 
+void
+ObjSurfMap::renumberSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber the surfaces in both maps 
+    \param RMap :: Map of old surface [+ve] : new surface
+  */
+{
+  ELog::RegMethod RegA("ObjSurfMap","renumberSurf");
+
+  if (RMap.empty()) return;
+  
+  auto newSurf=[&RMap](const int SN) -> int
+    {
+      std::map<int,int>::const_iterator mc=RMap.find(std::abs(SN));
+      if (mc==RMap.end()) return SN;
+      return (SN>0) ? mc->second : -mc->second;
+    };
+
+  OMTYPE newSMap;
+  for(OMTYPE::value_type& mc : SMap)
+    newSMap.emplace(newSurf(mc.first),std::move(mc.second));
+  SMap=std::move(newSMap);
+
+  for(OSTYPE::value_type& oc : OSurfMap)
+    {
+      surfTYPE newSet;
+      for(const int SN : oc.second)
+	newSet.insert(newSurf(SN));
+      oc.second=std::move(newSet);
+    }
+  return;
+}
 
 void
 ObjSurfMap::removeObject(const MonteCarlo::Object* OPtr)
@@ -51,6 +51,7 @@
 #include "Zaid.h"
 #include "MXcards.h"
 #include "Material.h"
+#include "AttnTable.h"
 #include "LineUnit.h"
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
@@ -144,24 +145,65 @@ ObjectTrackAct::getMatSum(const long int objN) const
   
 double
 ObjectTrackAct::getAttnSum(const long int objN,
-			   const double) const
+			   const double energy) const
   /*!
     Calculate the attenuatio of a beam traveling in teh object
     \param objN :: Cell number to use
-    \param energy :: energy of particle
-    \return sum of distance in non-void
+    \param energy :: energy of particle [MeV]
+    \return sum of attenuation in non-void
   */
 {
   ELog::RegMethod RegA("ObjectTrackAct","getAttnSum");
 
-
   std::map<long int,LineTrack>::const_iterator mc=Items.find(objN);
   if (mc==Items.end())
     throw ColErr::InContainerError<long int>(objN,"objN in Items");
   
   const std::vector<LineUnit>& trackVector=mc->second.getTrackPts();
+  const AttnTable& AT=AttnTable::Instance();
+  const size_t EGroup=AT.getGroup(energy);
 
   double sum(0.0);
+  for(const LineUnit& lu : trackVector)
+    {
+      const MonteCarlo::Object* OPtr=lu.objPtr;
+      if (OPtr)
+	{
+	  const MonteCarlo::Material* MPtr=OPtr->getMatPtr();
+	  if (!MPtr->isVoid())
+	    sum+=AT.trackAttn(*MPtr,lu.segmentLength,energy,EGroup);
+	}
+    }
+  return sum;
+}
+
+std::vector<double>
+ObjectTrackAct::getAttnSum(const long int objN,
+			   const std::vector<double>& EVec) const
+  /*!
+    Calculate the attenuation of a beam traveling in the object
+    for a set of energies in one pass of the track. The 
+    per-material factors are taken from the AttnTable [if built]
+    \param objN :: Cell number to use
+    \param EVec :: energy of particle for each output [MeV]
+    \return sum of attenuation for each energy
+  */
+{
+  ELog::RegMethod RegA("ObjectTrackAct","getAttnSum(vec)");
+
+  std::map<long int,LineTrack>::const_iterator mc=Items.find(objN);
+  if (mc==Items.end())
+    throw ColErr::InContainerError<long int>(objN,"objN in Items");
+  
+  const std::vector<LineUnit>& trackVector=mc->second.getTrackPts();
+  const AttnTable& AT=AttnTable::Instance();
+
+  // energy groups are found once per track
+  std::vector<size_t> EGroup;
+  for(const double E : EVec)
+    EGroup.push_back(AT.getGroup(E));
+  
+  std::vector<double> sum(EVec.size(),0.0);
   for(const LineUnit& lu : trackVector)
     {
       const MonteCarlo::Object* OPtr=lu.objPtr;
@@ -170,13 +212,12 @@ ObjectTrackAct::getAttnSum(const long int objN,
 	  const MonteCarlo::Material* MPtr=OPtr->getMatPtr();
 	  if (!MPtr->isVoid())
 	    {
-	      const double density=MPtr->getAtomDensity();
-	      const double AMean=MPtr->getMeanA();
-	      sum+=lu.segmentLength*std::pow(AMean,0.66)*density;
+	      for(size_t i=0;i<EVec.size();i++)
+		sum[i]+=AT.trackAttn(*MPtr,lu.segmentLength,
+				     EVec[i],EGroup[i]);
 	    }
 	}
     }
-  // currently no use for epsilon
   return sum;
 }
 
@@ -198,6 +239,22 @@ ObjectTrackAct::getDistance(const long int objN) const
   return mc->second.getTotalDist();
 }
 
+const LineTrack&
+ObjectTrackAct::getLine(const long int objN) const
+  /*!
+    Get the track to an object
+    \param objN :: Cell number to use
+    \return LineTrack
+  */
+{
+  ELog::RegMethod RegA("ObjectTrackAct","getLine");
+
+  std::map<long int,LineTrack>::const_iterator mc=Items.find(objN);
+  if (mc==Items.end())
+    throw ColErr::InContainerError<long int>(objN,"objN in Items");
+  return mc->second;
+}
+
 void
 ObjectTrackAct::createMatPath(std::vector<int>& matN,
 			      std::vector<double>& attnD) const
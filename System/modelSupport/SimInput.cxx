@@ -221,7 +221,8 @@ processExitChecks(Simulation& System,
       ELog::EM<<std::setprecision(12)<<"C == "<<C<<":"<<D<<ELog::endDiag;
       ModelSupport::LineTrack LT(C,D,10000.0);
       ModelSupport::LineTrack LTR(C,-D,10000.0);
-      LT.calculate(System);
+      if (LT.calculate(System))
+	ELog::EM<<"INIT POINT[error] == "<<C<<ELog::endCrit;
       //      LTR.calculate(System);
       ELog::EM<<std::setprecision(12)<<"Line == "<<LT<<ELog::endDiag;
     }
@@ -91,7 +91,15 @@ calcVolumes(Simulation* SimPtr,const mainSystem::inputParam& IParam)
 	  VTally.populateTally(*SMPtr);
 	}
 
-      VTally.pointRun(*SimPtr,NP);
+      if (IParam.flag("volError"))
+	{
+	  const double relErr=IParam.getValue<double>("volError",0);
+	  const size_t nStrata=
+	    IParam.getDefValue<size_t>(16,"volError",1);
+	  VTally.adaptiveRun(*SimPtr,relErr,nStrata,NP);
+	}
+      else
+	VTally.pointRun(*SimPtr,NP);
       ELog::EM<<"Volume == "<<Org<<" : "<<XYZ<<" : "<<NP<<ELog::endDiag;
       VTally.write("volumes");
     }
@@ -70,7 +70,8 @@ calcLineTrack(Simulation& System,
   ELog::RegMethod RegA("pipeSupport[F]","calcLineTrack");
   
   LineTrack LT(XP,YP);
-  LT.calculate(System);
+  if (LT.calculate(System))
+    ELog::EM<<"INIT POINT[error] == "<<XP<<ELog::endCrit;
   LT.populateObjMap(OMap);
   return;
 }
@@ -32,6 +32,7 @@
 #include <stack>
 #include <string>
 #include <algorithm>
+#include <functional>
 #include <memory>
 
 #include "Exception.h"
@@ -79,17 +80,11 @@ equalSurface(Geometry::Surface* SPtr)
 {
   if (!SPtr)
     throw ColErr::EmptyValue<Geometry::Surface*>("equalSurface");
-  const SMAP& sMap=surfIndex::Instance().surMap();
 
-  const Geometry::SurfKey cIndex=SPtr->classIndex();
-  for(const auto& [N, TPtr] : sMap)
-    {
-      if (TPtr->classIndex()==cIndex &&
-	  cmpSurfaces(SPtr,TPtr))
-	return TPtr;
-    }
+  Geometry::Surface* TPtr=
+    surfIndex::Instance().findEqualSurface(SPtr);
       
-  return SPtr;
+  return (TPtr) ? TPtr : SPtr;
 }
 
 const Geometry::Surface*
@@ -102,16 +97,11 @@ equalSurface(const Geometry::Surface* SPtr)
 {
   if (!SPtr)
     throw ColErr::EmptyValue<Geometry::Surface*>("equalSurface(const)");
-  const SMAP& sMap=surfIndex::Instance().surMap();
-  
 
-  for(const auto& [N, TPtr] : sMap)
-    {
-      if (cmpSurfaces(SPtr,TPtr))
-	return TPtr;
-    }
+  const Geometry::Surface* TPtr=
+    surfIndex::Instance().findEqualSurface(SPtr);
   
-  return SPtr;
+  return (TPtr) ? TPtr : SPtr;
 }
 
 int
@@ -258,4 +248,72 @@ oppositeSurfaces(const Geometry::Surface* SPtr,
   return (SP->isEqual(*TP)==-1) ? 1 : 0;
 }
 
+std::vector<size_t>
+surfHashKeys(const Geometry::Surface* SPtr,const bool oppFlag)
+  /*!
+    Calculate the hash keys of the buckets that can hold a
+    surface equal to SPtr. The canonical values of the surface
+    are quantised and the neighbouring bucket is also used
+    if a value is within tolerance of the bucket edge.
+     - Plane : distance / normal
+     - Cylinder : radius / |axis| [centre can slide on axis]
+     - Sphere : radius / centre
+     - Others : type only
+    \param SPtr :: Surface
+    \param oppFlag :: Keys for the opposite plane [-N,-D]
+    \return keys [first is the bucket of SPtr]
+  */
+{
+  const double quantum(1e-3);
+  const double edgeTol(10.0*Geometry::zeroTol);
+  
+  if (!SPtr) return std::vector<size_t>();
+
+  const Geometry::SurfKey sKey=SPtr->classIndex();
+  std::vector<double> Value;
+  if (sKey==Geometry::SurfKey::Plane)
+    {
+      const Geometry::Plane* PPtr=
+	static_cast<const Geometry::Plane*>(SPtr);
+      const double signV=(oppFlag) ? -1.0 : 1.0;
+      const Geometry::Vec3D& N=PPtr->getNormal();
+      Value={signV*PPtr->getDistance(),signV*N[0],signV*N[1],signV*N[2]};
+    }
+  else if (sKey==Geometry::SurfKey::Cylinder)
+    {
+      const Geometry::Cylinder* CPtr=
+	static_cast<const Geometry::Cylinder*>(SPtr);
+      const Geometry::Vec3D& N=CPtr->getNormal();
+      Value={CPtr->getRadius(),
+	     std::abs(N[0]),std::abs(N[1]),std::abs(N[2])};
+    }
+  else if (sKey==Geometry::SurfKey::Sphere)
+    {
+      const Geometry::Sphere* SphPtr=
+	static_cast<const Geometry::Sphere*>(SPtr);
+      const Geometry::Vec3D& C=SphPtr->getCentre();
+      Value={SphPtr->getRadius(),C[0],C[1],C[2]};
+    }
+
+  std::vector<size_t> Out({static_cast<size_t>(sKey)});
+  for(const double V : Value)
+    {
+      const double QV=V/quantum;
+      const long int index=static_cast<long int>(std::floor(QV));
+      std::vector<long int> QIndex({index});
+      if ((QV-static_cast<double>(index))*quantum<edgeTol)
+	QIndex.push_back(index-1);
+      if ((static_cast<double>(index+1)-QV)*quantum<edgeTol)
+	QIndex.push_back(index+1);
+
+      std::vector<size_t> nextOut;
+      for(const size_t H : Out)
+	for(const long int QI : QIndex)
+	  nextOut.push_back
+	    (H ^ (std::hash<long int>{}(QI)+0x9e3779b9+(H<<6)+(H>>2)));
+      Out=std::move(nextOut);
+    }
+  return Out;
+}
+
 } // NAMESPACE ModelSuppot
@@ -0,0 +1,102 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   modelSupportInc/AttnTable.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_AttnTable_h
+#define ModelSupport_AttnTable_h
+
+namespace MonteCarlo
+{
+  class Material;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class AttnTable
+  \version 1.0
+  \author S. Ansell
+  \date October 2026
+  \brief Attenuation factor per material and energy group
+
+  Holds A^0.66 and density for each material in DBMaterial 
+  and, if energy scaling is set, density * A^0.66 * energyFactor(E)
+  over log-spaced energy groups. It is built once [serially] 
+  before a tracking pass and is then read only, so can be shared 
+  by tracking threads. Materials not in the table are calculated 
+  directly. Without energy scaling the attenuation is the
+  energy independent length * A^0.66 * density.
+*/
+
+class AttnTable
+{
+ private:
+
+  bool energyScale;                   ///< Apply energyFactor
+  size_t NGroup;                      ///< Number of energy groups
+  std::vector<long int> matIndex;     ///< matID : row [-1 not present]
+  std::vector<double> matData;        ///< [row][A^0.66 : density]
+  std::vector<double> attnData;       ///< Table [row][group]
+
+  const double* getMatData(const MonteCarlo::Material&) const;
+
+  AttnTable();
+
+  ///\cond SINGLETON
+  AttnTable(const AttnTable&);
+  AttnTable& operator=(const AttnTable&);
+  ///\endcond SINGLETON
+
+ public:
+
+  static const double EMin;           ///< Lowest group edge [MeV]
+  static const double EMax;           ///< Highest group edge [MeV]
+  static const size_t nPerDecade;     ///< Groups per decade
+
+  static AttnTable& Instance();
+
+  /// Set the 1/v energy scaling [before build]
+  void setEnergyScale(const bool F) { energyScale=F; }
+  /// Energy scaling applied
+  bool hasEnergyScale() const { return energyScale; }
+  
+  double energyFactor(const double) const;
+  double calcAttn(const MonteCarlo::Material&,const double) const;
+
+  /// Table has been built
+  bool isBuilt() const { return NGroup!=0; }
+  /// Number of materials in the table
+  size_t getNMaterial() const { return matData.size()/2; }
+
+  void clear();
+  void build();
+
+  size_t getGroup(const double) const;
+  const double* getRow(const MonteCarlo::Material&) const;
+  double getAttn(const MonteCarlo::Material&,const double) const;
+  double trackAttn(const MonteCarlo::Material&,const double,
+		   const double,const size_t) const;
+
+};
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   modelSupportInc/CellBVH.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef ModelSupport_CellBVH_h
+#define ModelSupport_CellBVH_h
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace ModelSupport
+{
+
+/*!
+  \class CellBVH
+  \version 1.0
+  \author S. Ansell
+  \date October 2026
+  \brief Bounding volume hierarchy of cell boxes
+
+  Each cell is bound by a conservative axis aligned box
+  and the boxes are split recursively about the median centre
+  of the longest axis. Cells that cannot be bound are held
+  in a separate list and are always tested. The tree is
+  invalid once any bound cell clears its box.
+*/
+
+class CellBVH
+{
+ private:
+
+  /// Tree node : leaf if nItem is non-zero
+  struct BVHNode
+  {
+    Geometry::BBox Box;      ///< Box containing all the items
+    size_t leftIndex;        ///< Left child node
+    size_t rightIndex;       ///< Right child node
+    size_t firstItem;        ///< First item [leaf only]
+    size_t nItem;            ///< Number of items [leaf only]
+  };
+
+  static const size_t leafSize;  ///< Max number of items in a leaf
+  
+  bool active;                                   ///< Tree built
+  size_t buildChange;                            ///< Object change count
+  std::vector<BVHNode> Nodes;                    ///< Nodes [0 is root]
+  std::vector<Geometry::BBox> ItemBox;           ///< Cell boxes
+  std::vector<MonteCarlo::Object*> Items;        ///< Cells [tree order/0]
+  std::vector<MonteCarlo::Object*> Unbound;      ///< Cells without a box
+
+  /// Number of point queries [shared by tracking threads]
+  mutable std::atomic<size_t> nQuery;
+  mutable std::atomic<size_t> nTested;   ///< Number of cells tested
+
+  size_t buildNode(const size_t,const size_t);
+  std::vector<MonteCarlo::Object*>
+    findCandidates(const Geometry::Vec3D&) const;
+  
+ public:
+
+  CellBVH();
+  CellBVH(const CellBVH&);
+  CellBVH& operator=(const CellBVH&);
+  ~CellBVH() {}          ///< Destructor
+
+  void clearAll();
+  void build(const std::map<int,MonteCarlo::Object*>&);
+  void addObject(MonteCarlo::Object*);
+  void removeObject(const MonteCarlo::Object*);
+
+  bool isBuilt() const;
+  bool isStale() const;
+  /// Number of cells bound in the tree
+  size_t getNBound() const { return Items.size(); }
+  /// Number of cells not bound
+  size_t getNUnbound() const { return Unbound.size(); }
+  /// Number of point queries
+  size_t getNQuery() const { return nQuery; }
+  /// Number of cells tested by isValid
+  size_t getNTested() const { return nTested; }
+  void resetCount() const;
+  
+  MonteCarlo::Object* findCell(const Geometry::Vec3D&,
+			       const MonteCarlo::Object*,
+			       const MonteCarlo::Object*) const;
+
+  void write(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&,const CellBVH&);
+
+}
+
+#endif
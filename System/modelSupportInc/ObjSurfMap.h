@@ -84,6 +84,7 @@ class ObjSurfMap
   const std::set<int>& connectedObjects(const int) const;
   
   void removeReverseSurf(const int,const int);
+  void renumberSurf(const std::map<int,int>&);
   void removeObject(const MonteCarlo::Object*);
 
   void write(const std::string&) const;
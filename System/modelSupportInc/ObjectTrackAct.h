@@ -78,6 +78,8 @@ class ObjectTrackAct
   double getMatSum(const long int) const;
 
   double getAttnSum(const long int,const double =1e-6) const;
+  std::vector<double> getAttnSum(const long int,
+				 const std::vector<double>&) const;
   double getDistance(const long int) const;
 
   /// Debug function effectivley
@@ -34,6 +34,8 @@ int equalSurfNum(const Geometry::Surface*);
 bool cmpSurfaces(const Geometry::Surface*,const Geometry::Surface*);
 bool oppositeSurfaces(const Geometry::Surface*,const Geometry::Surface*);
 
+std::vector<size_t> surfHashKeys(const Geometry::Surface*,const bool);
+
 }
 
 #endif
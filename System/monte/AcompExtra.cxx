@@ -407,10 +407,10 @@ Acomp::interCombine(const Acomp& A,const Acomp& B)
       
   if (A.Intersect)
     return A.expandIIU(B);
-  
-  ELog::EM<<"Failure "<<ELog::endErr;
-  
-  return Acomp(1);
+
+  // no logging : this is used by the threaded cell minimization
+  throw ColErr::InvalidLine(A.display()+" / "+B.display(),
+			    "Acomp::interCombine union component");
 } 
 
 Acomp
@@ -40,10 +40,17 @@
 #include "OutputLog.h"
 #include "support.h"
 #include "MapSupport.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Vec3D.h"
 #include "BnId.h"
 #include "AcompTools.h"
 #include "Acomp.h"
 #include "Algebra.h"
+#include "Rules.h"
+#include "HeadRule.h"
+#include "Importance.h"
+#include "Object.h"
 
 namespace MonteCarlo
 {
@@ -524,6 +531,151 @@ Algebra::setFunctionObjStr(const std::string& A)
   return 0;
 }
 
+int
+Algebra::getLiteral(const int SN)
+  /*!
+    Get the literal of a surface. New surfaces are
+    added to the SurfMap
+    \param SN :: Signed surface number
+    \return signed literal
+  */
+{
+  const int ASN=std::abs(SN);
+  std::map<int,int>::const_iterator mc=SurfMap.find(ASN);
+  if (mc==SurfMap.end())
+    mc=SurfMap.emplace(ASN,static_cast<int>(SurfMap.size())+1).first;
+
+  return (SN>0) ? mc->second : -mc->second;
+}
+
+Acomp
+Algebra::makeComp(const Rule* RPtr,
+		  const std::map<int,Object*>* MList)
+  /*!
+    Convert a rule tree into an Acomp. Runs of the same join
+    are placed at one level and complements are expanded.
+    Surfaces are given literals in the order they are
+    written [same as setFunctionObjStr].
+    \param RPtr :: Rule to convert
+    \param MList :: Objects for \#cell units [if not populated]
+    \return Acomp [empty if no surfaces]
+  */
+{
+  ELog::RegMethod RegA("Algebra","makeComp");
+
+  Acomp Out(Inter);
+  if (!RPtr) return Out;
+  
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      Out.addIntersect(getLiteral(SPtr->getSignKeyN()));
+      return Out;
+    }
+
+  const int joinType(RPtr->type());
+  if (!joinType)
+    {
+      const CompObj* CPtr=dynamic_cast<const CompObj*>(RPtr);
+      if (CPtr)
+	{
+	  const Object* OPtr=CPtr->getObj();
+	  if (!OPtr && MList)
+	    {
+	      std::map<int,Object*>::const_iterator mc=
+		MList->find(CPtr->getObjN());
+	      if (mc!=MList->end())
+		OPtr=mc->second;
+	    }
+	  if (!OPtr)
+	    throw ColErr::InContainerError<int>
+	      (CPtr->getObjN(),"Unknown complementary unit");
+	  Out=makeComp(OPtr->topRule(),MList);
+	}
+      else if (dynamic_cast<const CompGrp*>(RPtr))
+	Out=makeComp(RPtr->leaf(0),MList);
+      else           // BoolValue : not written
+	return Out;
+
+      if (!Out.isNull())
+	Out.complement();
+      return Out;
+    }
+
+  if (joinType== -1)
+    Out=Acomp(Union);
+
+  // care to keep the left to right order:
+  std::stack<const Rule*> TreeLine;
+  TreeLine.push(RPtr);
+  while(!TreeLine.empty())
+    {
+      const Rule* tmpA=TreeLine.top();
+      TreeLine.pop();
+      if (!tmpA) continue;
+      
+      if (tmpA->type()==joinType)
+	{
+	  TreeLine.push(tmpA->leaf(1));
+	  TreeLine.push(tmpA->leaf(0));
+	}
+      else if ( (SPtr=dynamic_cast<const SurfPoint*>(tmpA)) )
+	{
+	  const int lit=getLiteral(SPtr->getSignKeyN());
+	  if (joinType==1)
+	    Out.addIntersect(lit);
+	  else
+	    Out.addUnion(lit);
+	}
+      else
+	{
+	  const Acomp subComp=makeComp(tmpA,MList);
+	  if (subComp.isNull()) continue;
+	  if (joinType==1)
+	    Out*=subComp;
+	  else
+	    Out+=subComp;
+	}
+    }
+  return Out;
+}
+
+int
+Algebra::setFunctionObj(const Rule* RPtr)
+  /*!
+    Fill the algebra (AComp) directly from a rule tree
+    without going via a string. 
+    \param RPtr :: Top rule of object
+    \retval -1 ::  Failure [no surfaces]
+    \retval 0 ::  Success
+  */
+{
+  ELog::RegMethod RegA("Algebra","setFunctionObj");
+
+  SurfMap.clear();
+  F=makeComp(RPtr,0);
+  return (F.isNull()) ? -1 : 0;
+}
+
+int
+Algebra::setFunctionObj(const Rule* RPtr,
+			const std::map<int,Object*>& MList)
+  /*!
+    Fill the algebra (AComp) directly from a rule tree
+    expanding \#cell units from the object list.
+    \param RPtr :: Top rule of object
+    \param MList :: Object map for \#cell units
+    \retval -1 ::  Failure [no surfaces]
+    \retval 0 ::  Success
+  */
+{
+  ELog::RegMethod RegA("Algebra","setFunctionObj(MList)");
+
+  SurfMap.clear();
+  F=makeComp(RPtr,&MList);
+  return (F.isNull()) ? -1 : 0;
+}
+
 int
 Algebra::setFunction(const std::string& A)
   /*!
@@ -681,6 +833,94 @@ Algebra::write(std::ostream& Out) const
   return Out;
 }
 
+void
+Algebra::makeRuleList(const Acomp& A,
+		       const std::map<int,int>& LitMap,
+		       std::vector<Rule*>& RVec) const
+  /*!
+    Add the items of a component to the rule list.
+    Sub-intersections of an intersection are added in-line
+    as they would be written by writeMCNPX.
+    \param A :: Component to add
+    \param LitMap :: Literal : surface number
+    \param RVec :: Rules to add to
+  */
+{
+  if (A.isTrue() || A.isFalse())
+    throw ColErr::InvalidLine(A.display(),"Algebra true/false unit");
+
+  for(const int lit : A.getUnits())
+    {
+      std::map<int,int>::const_iterator mc=LitMap.find(std::abs(lit));
+      if (mc==LitMap.end())
+	throw ColErr::InContainerError<int>(lit,"Algebra::SurfMap");
+      SurfPoint* SPtr=new SurfPoint();
+      SPtr->setKeyN((lit>0) ? mc->second : -mc->second);
+      RVec.push_back(SPtr);
+    }
+
+  const Acomp* ACPtr;
+  for(size_t i=0;(ACPtr=A.itemC(i));i++)
+    {
+      if (ACPtr->isInter() && A.isInter())
+	makeRuleList(*ACPtr,LitMap,RVec);
+      else
+	RVec.push_back(makeRule(*ACPtr,LitMap));
+    }
+  return;
+}
+
+Rule*
+Algebra::makeRule(const Acomp& A,
+		  const std::map<int,int>& LitMap) const
+  /*!
+    Convert an Acomp into a rule tree. The tree is built
+    as procString would build it from writeMCNPX.
+    \param A :: Component to convert
+    \param LitMap :: Literal : surface number
+    \return new Rule
+  */
+{
+  ELog::RegMethod RegA("Algebra","makeRule");
+
+  // Items are joined left to right [intersection first]
+  std::vector<Rule*> RVec;
+  makeRuleList(A,LitMap,RVec);
+  if (RVec.empty())
+    throw ColErr::EmptyContainer("Algebra::makeRule");
+
+  Rule* RPtr=RVec.front();
+  for(size_t i=1;i<RVec.size();i++)
+    {
+      if (A.isInter())
+	RPtr=new Intersection(RPtr,RVec[i]);
+      else
+	RPtr=new ::Union(RPtr,RVec[i]);
+    }
+  return RPtr;
+}
+
+HeadRule
+Algebra::writeHeadRule() const
+  /*!
+    Writes the algebra directly as a HeadRule of 
+    surface numbers [without going via writeMCNPX].
+    \return HeadRule of algebra
+  */
+{
+  ELog::RegMethod RegA("Algebra","writeHeadRule");
+
+  std::map<int,int> LitMap;
+  for(const auto& [SN,lit] : SurfMap)
+    LitMap.emplace(lit,SN);
+
+  Rule* RPtr=makeRule(F,LitMap);
+  HeadRule Out;
+  Out.procRule(RPtr);
+  delete RPtr;
+  return Out;
+}
+
 std::string
 Algebra::writeMCNPX() const
   /*!
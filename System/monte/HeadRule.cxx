@@ -45,10 +45,13 @@
 #include "mathSupport.h"
 #include "stringCombine.h"
 #include "Vec3D.h"
+#include "BBox.h"
 #include "interPoint.h"
 #include "Surface.h"
 #include "Quadratic.h"
 #include "Plane.h"
+#include "Cylinder.h"
+#include "Sphere.h"
 #include "BnId.h"
 #include "AcompTools.h"
 #include "Acomp.h"
@@ -59,6 +62,7 @@
 #include "LineIntersectVisit.h"
 #include "surfRegister.h"
 #include "MapSupport.h"
+#include "RuleEval.h"
 #include "HeadRule.h"
 
 #include "SurInter.h"
@@ -78,14 +82,14 @@ operator<<(std::ostream& OX,const HeadRule& A)
 }
 
 HeadRule::HeadRule() :
-  HeadNode(nullptr)
+  HeadNode(nullptr),EvalPtr(nullptr)
   /*!
     Creates a new rule
   */
 {}
 
 HeadRule::HeadRule(const std::string& RuleStr) :
-  HeadNode(nullptr)
+  HeadNode(nullptr),EvalPtr(nullptr)
   /*!
     Creates a new rule
     \param RuleStr :: rule in MCNP format
@@ -97,7 +101,7 @@ HeadRule::HeadRule(const std::string& RuleStr) :
 }
 
 HeadRule::HeadRule(const int surfNum) :
-  HeadNode(nullptr)
+  HeadNode(nullptr),EvalPtr(nullptr)
   /*!
     Creates a new rule
     \param surfNum :: rule as surface number
@@ -134,7 +138,8 @@ HeadRule::HeadRule(const ModelSupport::surfRegister& SMap,
 {}
 
 HeadRule::HeadRule(const Rule* RPtr) :
-  HeadNode((RPtr) ? RPtr->clone() : nullptr)
+  HeadNode((RPtr) ? RPtr->clone() : nullptr),
+  EvalPtr(nullptr)
   /*!
     Creates a new rule
     \param RPtr :: Rule to clone as a top rule
@@ -146,7 +151,8 @@ HeadRule::HeadRule(const Rule* RPtr) :
 HeadRule::HeadRule(const HeadRule& A) :
   HeadNode((A.HeadNode) ? A.HeadNode->clone() : nullptr),
   signPairedSurf(A.signPairedSurf),
-  surfSet(A.surfSet)
+  surfSet(A.surfSet),
+  EvalPtr((A.EvalPtr) ? new RuleEval(*A.EvalPtr) : nullptr)
   /*!
     Copy constructor
     \param A :: Head rule to copy
@@ -156,13 +162,15 @@ HeadRule::HeadRule(const HeadRule& A) :
 HeadRule::HeadRule(HeadRule&& A) :
   HeadNode(std::move(A.HeadNode)),
   signPairedSurf(std::move(A.signPairedSurf)),
-  surfSet(std::move(A.surfSet))
+  surfSet(std::move(A.surfSet)),
+  EvalPtr(A.EvalPtr)
   /*!
     Move constructor [needed because of explicit new ptr]
     \param A :: Head rule to move
   */
 {
   A.HeadNode=nullptr;   // This is deleted so must reset
+  A.EvalPtr=nullptr;
 }
 
 HeadRule&
@@ -179,6 +187,8 @@ HeadRule::operator=(const HeadRule& A)
       HeadNode=(A.HeadNode) ? A.HeadNode->clone() : 0;
       signPairedSurf=A.signPairedSurf;
       surfSet=A.surfSet;
+      delete EvalPtr;
+      EvalPtr=(A.EvalPtr) ? new RuleEval(*A.EvalPtr) : nullptr;
     }
   return *this;
 }
@@ -189,6 +199,18 @@ HeadRule::~HeadRule()
   */
 {
   delete HeadNode;
+  delete EvalPtr;
+}
+
+void
+HeadRule::clearEval()
+  /*!
+    Remove the compiled rule [rule changed]
+  */
+{
+  delete EvalPtr;
+  EvalPtr=nullptr;
+  return;
 }
 
 bool
@@ -485,6 +507,7 @@ HeadRule::subMatched(const HeadRule& A,
   */
 {
   ELog::RegMethod RegA("HeadRule","subMatched");
+  clearEval();
 
   if (!A.HeadNode || !HeadNode) return 0;
 
@@ -707,6 +730,7 @@ HeadRule::reset()
     Assuming that the head-rule needs to be reset
    */
 {
+  clearEval();
   delete HeadNode;
   HeadNode=0;
   return;
@@ -763,6 +787,164 @@ HeadRule::isZeroVolume() const
   return 1;
 }
 
+Geometry::BBox
+HeadRule::calcSurfBox(const Geometry::Surface* SPtr,const int signV)
+  /*!
+    Calculate the conservative bounding box of a surface half-space.
+    Only planes aligned with an axis, cylinders with axis
+    perpendicular to a coordinate and spheres (inside) give
+    a limit. Everything else is unbounded.
+    \param SPtr :: Surface 
+    \param signV :: Sign of the half-space
+    \return box containing the half-space
+  */
+{
+  const double axisTol(1e-12);
+  
+  Geometry::BBox Out;
+  if (!SPtr) return Out;
+
+  if (SPtr->classIndex()==Geometry::SurfKey::Plane)
+    {
+      const Geometry::Plane* PPtr=
+	static_cast<const Geometry::Plane*>(SPtr);
+      const Geometry::Vec3D NV=PPtr->getNormal()*signV;
+      const double D=PPtr->getDistance()*signV;
+      // need exact alignment : any tilt is unbounded over the model
+      const size_t index=NV.principleDir();
+      if (std::abs(NV[(index+1) % 3])<axisTol &&
+	  std::abs(NV[(index+2) % 3])<axisTol)
+	{
+	  const double V=D/NV[index];
+	  if (NV[index]>0.0)
+	    Out.setAxisRange(index,V,std::numeric_limits<double>::infinity());
+	  else
+	    Out.setAxisRange(index,-std::numeric_limits<double>::infinity(),V);
+	}
+    }
+  else if (signV<0 && SPtr->classIndex()==Geometry::SurfKey::Cylinder)
+    {
+      const Geometry::Cylinder* CPtr=
+	static_cast<const Geometry::Cylinder*>(SPtr);
+      const Geometry::Vec3D& C=CPtr->getCentre();
+      const Geometry::Vec3D& A=CPtr->getNormal();
+      const double R=CPtr->getRadius();
+      for(size_t i=0;i<3;i++)
+	if (std::abs(A[i])<axisTol)
+	  Out.setAxisRange(i,C[i]-R,C[i]+R);
+    }
+  else if (signV<0 && SPtr->classIndex()==Geometry::SurfKey::Sphere)
+    {
+      const Geometry::Sphere* SphPtr=
+	static_cast<const Geometry::Sphere*>(SPtr);
+      const Geometry::Vec3D& C=SphPtr->getCentre();
+      const double R=SphPtr->getRadius();
+      for(size_t i=0;i<3;i++)
+	Out.setAxisRange(i,C[i]-R,C[i]+R);
+    }
+
+  Out.grow(Geometry::shiftTol);
+  return Out;
+}
+
+Geometry::BBox
+HeadRule::calcRuleBox(const Rule* RPtr)
+  /*!
+    Calculate the bounding box of a rule by
+    intersection/union of the leaf boxes. Complement 
+    items are unbounded.
+    \param RPtr :: Rule to process
+    \return box containing the rule
+  */
+{
+  if (!RPtr) return Geometry::BBox();
+
+  const int RType=RPtr->type();
+  if (RType==1)
+    return calcRuleBox(RPtr->leaf(0))*calcRuleBox(RPtr->leaf(1));
+  if (RType==-1)
+    return calcRuleBox(RPtr->leaf(0))+calcRuleBox(RPtr->leaf(1));
+
+  const SurfPoint* SurX=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SurX)
+    return calcSurfBox(SurX->getKey(),SurX->getSign());
+
+  // complement / bool value : no limit
+  return Geometry::BBox();
+}
+
+Geometry::BBox
+HeadRule::calcBoundBox() const
+  /*!
+    Calculate a conservative axis aligned bounding box
+    for the rule. Requires the rule to be populated.
+    \return box [infinite on unbounded/unknown sides]
+  */
+{
+  return calcRuleBox(HeadNode);
+}
+
+bool
+HeadRule::isBoundPolytope() const
+  /*!
+    Determine if the rule is a pure intersection of planes
+    that encloses a finite region. The recession cone of the
+    region is tested by the ray direction of each plane pair
+    [extreme rays are cross products of two inward normals]
+    \retval 1 :: intersection of planes and bounded
+    \retval 0 :: not a polytope / unbounded
+  */
+{
+  if (!HeadNode) return 0;
+  
+  std::vector<Geometry::Vec3D> NVec;
+  std::stack<const Rule*> TreeLine;
+  TreeLine.push(HeadNode);
+  while(!TreeLine.empty())
+    {
+      const Rule* RPtr=TreeLine.top();
+      TreeLine.pop();
+      if (!RPtr) return 0;
+      if (RPtr->type()==1)
+	{
+	  TreeLine.push(RPtr->leaf(0));
+	  TreeLine.push(RPtr->leaf(1));
+	}
+      else
+	{
+	  const SurfPoint* SurX=dynamic_cast<const SurfPoint*>(RPtr);
+	  if (!SurX || !SurX->getKey() ||
+	      SurX->getKey()->classIndex()!=Geometry::SurfKey::Plane)
+	    return 0;
+	  const Geometry::Plane* PPtr=
+	    static_cast<const Geometry::Plane*>(SurX->getKey());
+	  NVec.push_back(PPtr->getNormal()*SurX->getSign());
+	}
+    }
+
+  bool pairFlag(0);
+  for(size_t i=0;i<NVec.size();i++)
+    for(size_t j=i+1;j<NVec.size();j++)
+      {
+	Geometry::Vec3D RVec=NVec[i]*NVec[j];
+	if (RVec.abs()<Geometry::zeroTol) continue;
+	RVec.makeUnit();
+	pairFlag=1;
+	for(const double signV : {1.0,-1.0})
+	  {
+	    bool rayFlag(1);
+	    for(const Geometry::Vec3D& NV : NVec)
+	      if (NV.dotProd(RVec)*signV < -Geometry::zeroTol)
+		{
+		  rayFlag=0;
+		  break;
+		}
+	    if (rayFlag) return 0;     // unbounded direction
+	  }
+      }
+  return pairFlag;
+}
+
 void
 HeadRule::populateSurf()
   /*!
@@ -770,11 +952,15 @@ HeadRule::populateSurf()
   */
 {
   ELog::RegMethod RegA("HeadRule","populateSurf");
+  clearEval();
   if (HeadNode)
     {
       HeadNode->populateSurf();
       signPairedSurf=getOppositeSurfaces();
       calcSurfaces();
+      EvalPtr=new RuleEval(HeadNode,signPairedSurf);
+      if (!EvalPtr->isCompiled())
+	clearEval();
     }
   return;
 }
@@ -811,6 +997,9 @@ HeadRule::isValid(const Geometry::Vec3D& Pt,
 {
   if (!HeadNode) return 0;
 
+  if (EvalPtr)
+    return EvalPtr->isValid(Pt,S);
+  
   std::map<int,int> SMap; 
   if (!signPairedSurf.empty())
     {
@@ -846,6 +1035,8 @@ HeadRule::isSideValid(const Geometry::Vec3D& Pt,
   */
 {
   if (!HeadNode) return 0;
+  if (EvalPtr)
+    return EvalPtr->isSideValid(Pt,S);
 
   std::map<int,int> SMap; 
   if (!signPairedSurf.empty())
@@ -879,6 +1070,8 @@ HeadRule::isAnyValid(const Geometry::Vec3D& Pt,
   */
 {
   if (!HeadNode) return 0;
+  if (EvalPtr)
+    return EvalPtr->isAnyValid(Pt,SSet);
 
   std::map<int,int> SMap;
 
@@ -913,6 +1106,9 @@ HeadRule::isValid(const Geometry::Vec3D& Pt) const
     \return true/false 
   */
 {
+  if (EvalPtr)
+    return EvalPtr->isValid(Pt);
+  
   //early return for normal case:
   if (signPairedSurf.empty() || !HeadNode)
     return (HeadNode) ? HeadNode->isValid(Pt) : 0;
@@ -1019,6 +1215,17 @@ HeadRule::surfValid(const Geometry::Vec3D& Pt) const
 	}
     }
   if (STest.empty()) return sideSurf;
+
+  if (EvalPtr)
+    {
+      std::set<int> freeSet;
+      for(const auto& [SN,side] : STest)
+	freeSet.emplace(SN);
+      for(const int SN : freeSet)
+	if (RuleEval::isDifferent(*EvalPtr,*EvalPtr,Pt,freeSet,SN))
+	  sideSurf.emplace(SN);
+      return sideSurf;
+    }
   /*
     Loop over all STest to find any surface that there is
     a +/- for ANY cobmination of any other surface binarys
@@ -1060,6 +1267,7 @@ HeadRule::isolateSurfNum(const std::set<int>& SN)
    */
 {
   ELog::RegMethod RegA("HeadRule","isolateSurfNum");
+  clearEval();
 
   // FIRST PASS: [Eliminate -- all zero surfaces]
   std::stack<Rule*> TreeLine;
@@ -1384,6 +1592,7 @@ HeadRule::removeTopItem(const int SN)
   */
 {
   ELog::RegMethod RegA("HeadRule","removeTopItem");
+  clearEval();
 
   if (!HeadNode) return 0;
 
@@ -1438,6 +1647,7 @@ HeadRule::removeUnsignedItems(const int SN)
   */
 {
   ELog::RegMethod RegA("HeadRule","removeUnsignedItems");
+  clearEval();
 
   const int cntA=removeItems(SN);
   if (cntA<0) return cntA;
@@ -1463,6 +1673,7 @@ HeadRule::removeOuterPlane(const Geometry::Vec3D& LOrig,
   */
 {
   ELog::RegMethod RegA("HeadRule","removeOuterPlane");
+  clearEval();
 
   if (!HeadNode) return -1;
 
@@ -1522,6 +1733,7 @@ HeadRule::removeMatchedPlanes(const Geometry::Vec3D& ZAxis,
   */
 {
   ELog::RegMethod RegA("HeadRule","removeMatchedPlanes");
+  clearEval();
 
   if (!HeadNode) return -1;
 
@@ -1546,6 +1758,7 @@ HeadRule::removeItems(const int SN)
   */
 {
   ELog::RegMethod RegA("HeadRule","removeItems");
+  clearEval();
 
   if (!HeadNode) return -1;
 
@@ -1948,6 +2161,7 @@ HeadRule::removeItem(const Rule* Target)
   */
 {
   ELog::RegMethod RegA("HeadRule","removeItem");
+  clearEval();
   if (!Target) return;
   Rule* P=Target->getParent();
   if (!P)
@@ -1988,6 +2202,7 @@ HeadRule::removeCommon()
   */
 {
   ELog::RegMethod RegA("HeadRule","removeCommon");
+  clearEval();
 
   if (!HeadNode) 
     return;
@@ -2063,6 +2278,7 @@ HeadRule::substituteSurf(const ModelSupport::surfRegister& SMap,
   */
 {
   ELog::RegMethod RegA("HeadRule","substitueSurf(SMAP,3int)");
+  clearEval();
   // Quick check:
   if (surfN==newSurfN) return 0;
   int surfPair[2]={surfN,newSurfN};
@@ -2091,6 +2307,7 @@ HeadRule::substituteSurf(const ModelSupport::surfRegister& SMap,
   */
 {
   ELog::RegMethod RegA("HeadRule","substitueSurf(SMAP)");
+  clearEval();
   // Quick check:
   if (surfN==newSurfN) return 0;
   return substituteSurf
@@ -2112,6 +2329,7 @@ HeadRule::substituteSurf(const int SurfN,const int newSurfN,
   */
 {
   ELog::RegMethod RegA("HeadRule","substitueSurf");
+  clearEval();
 
 
   // Quick check:
@@ -2130,6 +2348,56 @@ HeadRule::substituteSurf(const int SurfN,const int newSurfN,
   return cnt;
 }
 
+int
+HeadRule::substituteSurf(const std::map<int,int>& RMap)
+  /*!
+    Substitues all the surfaces in the map in one pass
+    of the tree. +surfN is converted to newSurfN, and -surfN
+    is converted to -newSurfN. The surface pointers are not
+    changed as the surfaces are assumed to be renamed.
+    \param RMap :: Map of surfN [+ve] : newSurfN
+    \returns number of substitutions
+  */
+{
+  ELog::RegMethod RegA("HeadRule","substitueSurf(map)");
+
+  if (!HeadNode || RMap.empty()) return 0;
+  clearEval();
+
+  int cnt(0);
+  std::stack<Rule*> TreeLine;
+  TreeLine.push(HeadNode);
+  while(!TreeLine.empty())
+    {
+      Rule* tmpA=TreeLine.top();
+      TreeLine.pop();
+      Rule* tmpB=tmpA->leaf(0);
+      Rule* tmpC=tmpA->leaf(1);
+      if (tmpB || tmpC)
+	{
+	  if (tmpB)
+	    TreeLine.push(tmpB);
+	  if (tmpC)
+	    TreeLine.push(tmpC);
+	}
+      else
+	{
+	  SurfPoint* SurX=dynamic_cast<SurfPoint*>(tmpA);
+	  if (SurX)
+	    {
+	      std::map<int,int>::const_iterator mc=
+		RMap.find(SurX->getKeyN());
+	      if (mc!=RMap.end() && mc->first!=mc->second)
+		{
+		  SurX->setKeyN(SurX->getSign()*mc->second);
+		  cnt++;
+		}
+	    }
+	}
+    }
+  return cnt;
+}
+
 void
 HeadRule::removeComplement()
   /*!
@@ -2137,6 +2405,7 @@ HeadRule::removeComplement()
    */
 {
   ELog::RegMethod RegA("HeadRule","removeComplement");
+  clearEval();
 
   if (!HeadNode) return;
   MonteCarlo::Algebra AX;
@@ -2154,6 +2423,7 @@ HeadRule::makeComplement()
    */
 {
   ELog::RegMethod RegA("HeadRule","makeComplement");
+  clearEval();
 
   if (!HeadNode) return;
   MonteCarlo::Algebra AX;
@@ -2303,6 +2573,7 @@ HeadRule::addIntersection(const std::string& RStr)
   */
 {
   ELog::RegMethod RegA("HeadRule","addIntersection(string)");
+  clearEval();
   if (!RStr.empty())
     {
       HeadRule A;
@@ -2324,6 +2595,7 @@ HeadRule::addUnion(const std::string& RStr)
    */
 {
   ELog::RegMethod RegA("HeadRule","addUnion(string)");
+  clearEval();
   HeadRule A;
   if (A.procString(RStr))
     addUnion(A.getTopRule());
@@ -2341,6 +2613,7 @@ HeadRule::addIntersection(const HeadRule& AHead)
   */
 {
   ELog::RegMethod RegA("HeadRule","addIntersection<HeadRule>");
+  clearEval();
 
   if (AHead.HeadNode)
     {
@@ -2362,6 +2635,7 @@ HeadRule::addUnion(const HeadRule& AHead)
   */
 {
   ELog::RegMethod RegA("HeadRule","addUnion<HeadRule>");
+  clearEval();
   
   if (AHead.HeadNode)
     {
@@ -2382,6 +2656,7 @@ HeadRule::addIntersection(const Rule* RPtr)
    */
 {
   ELog::RegMethod RegA("HeadRule","addIntersection<Rule>");
+  clearEval();
   if (RPtr)
     {
       if (!HeadNode)
@@ -2401,6 +2676,7 @@ HeadRule::addUnion(const Rule* RPtr)
    */
 {
   ELog::RegMethod RegA("HeadRule","addUnion");
+  clearEval();
   if (RPtr)
     {
       if (!HeadNode)
@@ -2421,6 +2697,7 @@ HeadRule::createAddition(const int InterFlag,const Rule* NRptr)
    */
 {
   ELog::RegMethod RegA("HeadRule","createAddition");
+  clearEval();
 
   // This is an intersection and we want to add our rule at the base
   // Find first item that is not an intersection
@@ -2468,6 +2745,7 @@ HeadRule::procSurface(const Geometry::Surface* SPtr)
   */
 {
   ELog::RegMethod RegA("HeadRule","procSurface");
+  clearEval();
 
   delete HeadNode;
   HeadNode=0;
@@ -2489,6 +2767,7 @@ HeadRule::procRule(const Rule* RPtr)
   */
 {
   ELog::RegMethod RegA("HeadRule","procRule");
+  clearEval();
 
 
   delete HeadNode;
@@ -2511,6 +2790,7 @@ HeadRule::procSurfNum(const int SN)
   */
 {
   ELog::RegMethod RegA("HeadRule","procSurfNum");
+  clearEval();
 
   if (!SN) return 0;
 
@@ -2535,6 +2815,7 @@ HeadRule::procString(const std::string& Line)
   */
 {
   ELog::RegMethod RegA("HeadRule","procString");
+  clearEval();
 
   if (StrFunc::isEmpty(Line)) return 0;
 
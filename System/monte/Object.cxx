@@ -47,6 +47,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "Vec3D.h"
+#include "BBox.h"
 #include "Line.h"
 #include "interPoint.h"
 #include "LineIntersectVisit.h"
@@ -64,10 +65,16 @@
 #include "DBMaterial.h"
 #include "Importance.h"
 #include "Object.h"
+#include "vertexCalc.h"
 
 namespace MonteCarlo
 {
 
+/// Max surfaces to use vertex points to tighten the box 
+const size_t maxVertexSurf(40);
+
+size_t Object::bvhChange(0);
+
 std::ostream&
 operator<<(std::ostream& OX,const Object& A)
 /*!
@@ -88,7 +95,7 @@ Object::Object() :
   trcl(0),populated(0),
   activeMag(0),magMinStep(1e-3),magMaxStep(1e-1),
   activeElec(0),elecMinStep(1e-3),elecMaxStep(1e-1),
-  objSurfValid(0)
+  comValid(0),boxValid(0),bvhFlag(0),objSurfValid(0)
    /*!
      Defaut constuctor, set temperature to 300C and material to vacuum
    */
@@ -101,7 +108,7 @@ Object::Object(const int N,const int M,
   trcl(0),populated(0),
   activeMag(0),magMinStep(1e-3),magMaxStep(1e-1),
   activeElec(0),elecMinStep(1e-3),elecMaxStep(1e-1),
-  objSurfValid(0)
+  comValid(0),boxValid(0),bvhFlag(0),objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -120,7 +127,7 @@ Object::Object(const int N,const int M,
   trcl(0),populated(0),
   activeMag(0),magMinStep(1e-3),magMaxStep(1e-1),
   activeElec(0),elecMinStep(1e-3),elecMaxStep(1e-1),
-  HRule(std::move(HR)),objSurfValid(0)
+  HRule(std::move(HR)),comValid(0),boxValid(0),bvhFlag(0),objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -137,7 +144,7 @@ Object::Object(std::string  FCName,const int N,const int M,
   trcl(0),populated(0),
   activeMag(0),magMinStep(1e-3),magMaxStep(1e-1),
   activeElec(0),elecMinStep(1e-3),elecMaxStep(1e-1),
-  objSurfValid(0)
+  comValid(0),boxValid(0),bvhFlag(0),objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -157,7 +164,7 @@ Object::Object(std::string  FCName,const int N,const int M,
   activeMag(0),magMinStep(1e-3),magMaxStep(1e-1),
   activeElec(0),elecMinStep(1e-3),elecMaxStep(1e-1),
   HRule(std::move(HR)),
-  objSurfValid(0)
+  comValid(0),boxValid(0),bvhFlag(0),objSurfValid(0)
  /*!
    Constuctor, set temperature to 300C 
    \param N :: number
@@ -174,7 +181,9 @@ Object::Object(const Object& A) :
   activeMag(A.activeMag),magMinStep(A.magMinStep),
   magMaxStep(A.magMaxStep),activeElec(A.activeElec),
   elecMinStep(A.elecMinStep),elecMaxStep(A.elecMaxStep),
-  HRule(A.HRule),objSurfValid(0),
+  HRule(A.HRule),comValid(A.comValid),COM(A.COM),
+  boxValid(A.boxValid),
+  boxLow(A.boxLow),boxHigh(A.boxHigh),bvhFlag(0),objSurfValid(0),
   surfSet(A.surfSet),surNameSet(A.surNameSet)
   /*!
     Copy constructor
@@ -207,6 +216,12 @@ Object::operator=(const Object& A)
       elecMinStep=A.elecMinStep;
       elecMaxStep=A.elecMaxStep;
       HRule=A.HRule;
+      comValid=A.comValid;
+      COM=A.COM;
+      boxValid=A.boxValid;
+      boxLow=A.boxLow;
+      boxHigh=A.boxHigh;
+      if (bvhFlag) bvhChange++;
       objSurfValid=0;
       surfSet=A.surfSet;
       surNameSet=A.surNameSet;
@@ -238,6 +253,7 @@ Object::clearValid()
    */
 {
   populated=0;
+  clearBoundBox();
   surNameSet.clear();
   surfSet.clear();
   objSurfValid=0;
@@ -371,6 +387,7 @@ Object::complementaryObject(const int Cnum,std::string& Ln)
   if (!HRule.procString(Part))
     throw ColErr::InvalidLine(Part,"HRule::procString");
 
+  clearBoundBox();
   surfSet.clear();
   surNameSet.clear();
   Ln.erase(posA-1,posB+1);  //Delete brackets ( Part ) .
@@ -561,6 +578,7 @@ Object::rePopulate()
   ELog::RegMethod RegA("Object","rePopulate");
   HRule.populateSurf();
   populated=1;
+  clearBoundBox();
   return;
 }
 
@@ -784,6 +802,7 @@ Object::isValid(const Geometry::Vec3D& Pt) const
   \returns 1 if true and 0 if false
 */
 {
+  if (!inBoundBox(Pt)) return 0;
   return HRule.isValid(Pt);
 }
 
@@ -1024,6 +1043,114 @@ Object::createSurfaceList()
   return 1;
 }
 
+void
+Object::calcBoundBox() const
+  /*!
+    Calculate the conservative bounding box from the
+    surfaces. Cells made only of planes are tightened using
+    the vertex points if the cell is closed.
+    Requires surfSet to be populated.
+    Not thread safe for the same object.
+  */
+{
+  ELog::RegMethod RegA("Object","calcBoundBox");
+
+  boxValid=0;
+  Geometry::BBox Box=HRule.calcBoundBox();
+
+  if (!Box.isEmpty() && surfSet.size()<=maxVertexSurf &&
+      (!Box.isInfinite() || HRule.isBoundPolytope()))
+    {
+      bool planeFlag(1);
+      for(const Geometry::Surface* SPtr : surfSet)
+	if (SPtr->classIndex()!=Geometry::SurfKey::Plane)
+	  {
+	    planeFlag=0;
+	    break;
+	  }
+      if (planeFlag)
+	{
+	  const std::vector<Geometry::Vec3D> VPts=
+	    ModelSupport::calcVertexPoints(*this);
+	  if (!VPts.empty())
+	    {
+	      Geometry::BBox VBox(Geometry::BBox::emptyBox());
+	      for(const Geometry::Vec3D& Pt : VPts)
+		VBox.addPoint(Pt);
+	      VBox.grow(Geometry::shiftTol);
+	      Box*=VBox;
+	    }
+	}
+    }
+  boxLow=Box.getLow();
+  boxHigh=Box.getHigh();
+  boxValid=1;
+  return;
+}
+
+const Geometry::Vec3D&
+Object::getCofM() const
+  /*!
+    Get the centre of mass [vertex average]. This is
+    calculated on first use and kept until the HeadRule changes.
+    Not thread safe for the same object on first call.
+    \return centre of mass [0,0,0 if no vertex]
+  */
+{
+  if (!comValid)
+    {
+      COM=ModelSupport::calcCOFM(*this);
+      comValid=1;
+    }
+  return COM;
+}
+
+void
+Object::clearBoundBox()
+  /*!
+    Remove the bounding box and centre of mass
+    [rule changed / surfaces moved]. If the object is held
+    in a cell BVH the change count is increased so
+    the tree is no longer valid.
+  */
+{
+  comValid=0;
+  boxValid=0;
+  if (bvhFlag) bvhChange++;
+  return;
+}
+
+Geometry::BBox
+Object::getBoundBox() const
+  /*!
+    Get the bounding box of the object. This is
+    calculated on first use and kept until the HeadRule changes.
+    Not thread safe on first call : boxes are filled serially
+    by the cell BVH build before any threaded tracking.
+    \return box [all space if surfaces not populated]
+  */
+{
+  if (!boxValid && !surfSet.empty())
+    calcBoundBox();
+  return (boxValid) ? Geometry::BBox(boxLow,boxHigh) : Geometry::BBox();
+}
+
+bool
+Object::inBoundBox(const Geometry::Vec3D& Pt) const
+  /*!
+    Quick test if a point is within the bounding box.
+    Read only [safe from tracking threads] : the box is not
+    calculated here so no box passes every point.
+    \param Pt :: Point to test
+    \return false only if the point is definately outside
+  */
+{
+  return (!boxValid ||
+	  (Pt[0]>=boxLow[0] && Pt[0]<=boxHigh[0] &&
+	   Pt[1]>=boxLow[1] && Pt[1]<=boxHigh[1] &&
+	   Pt[2]>=boxLow[2] && Pt[2]<=boxHigh[2]));
+}
+
 bool
 Object::isVoid() const
   /*!
@@ -1088,6 +1215,7 @@ Object::removeSurface(const int SurfN)
   const int cnt=HRule.removeItems(SurfN);
   if (cnt>0)
     {
+      clearBoundBox();
       createSurfaceList();
       objSurfValid=0;
     }
@@ -1116,6 +1244,28 @@ Object::substituteSurf(const int SurfN,
   if (out)
     {
       populated=0;
+      clearBoundBox();
+      createSurfaceList();
+    }
+  return out;
+}
+
+int
+Object::substituteSurf(const std::map<int,int>& RMap)
+  /*! 
+    Renumbers all the surfaces in the map and then
+    re-builds the cell once.
+    \param RMap :: Map of old surface number : new surface number
+    \return number of surfaces substituted
+  */
+{ 
+  ELog::RegMethod RegA("Object","substituteSurf(map)");
+
+  const int out=HRule.substituteSurf(RMap);
+  if (out)
+    {
+      populated=0;
+      clearBoundBox();
       createSurfaceList();
     }
   return out;
@@ -1294,6 +1444,7 @@ Object::makeComplement()
    */
 {
   HRule.makeComplement();
+  clearBoundBox();
   return;
 }
 
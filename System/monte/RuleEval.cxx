@@ -0,0 +1,578 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monte/RuleEval.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <sstream>
+#include <algorithm>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Rules.h"
+#include "RuleEval.h"
+
+std::ostream&
+operator<<(std::ostream& OX,const RuleEval& A)
+  /*!
+    Standard output stream
+    \param OX :: Output stream
+    \param A :: RuleEval to write
+    \return Stream State
+   */
+{
+  A.write(OX);
+  return OX;
+}
+
+RuleEval::RuleEval(const Rule* RPtr,
+		   const std::set<const Geometry::Surface*>& pairSurf) :
+  compiled(0)
+  /*!
+    Constructor : flatten the rule
+    \param RPtr :: Top rule [populated]
+    \param pairSurf :: Surfaces that appear with both signs
+  */
+{
+  if (RPtr && compileRule(RPtr))
+    {
+      compiled=1;
+      for(size_t i=0;i<SurfVec.size();i++)
+	if (pairSurf.find(SurfVec[i])!=pairSurf.end())
+	  pairIndex.push_back(i);
+    }
+  else
+    {
+      Units.clear();
+      SurfVec.clear();
+      SurfN.clear();
+    }
+}
+
+RuleEval::RuleEval(const RuleEval& A) :
+  compiled(A.compiled),Units(A.Units),
+  SurfVec(A.SurfVec),SurfN(A.SurfN),
+  pairIndex(A.pairIndex)
+  /*!
+    Copy constructor
+    \param A :: RuleEval to copy
+  */
+{}
+
+RuleEval&
+RuleEval::operator=(const RuleEval& A)
+  /*!
+    Assignment operator
+    \param A :: RuleEval to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      compiled=A.compiled;
+      Units=A.Units;
+      SurfVec=A.SurfVec;
+      SurfN=A.SurfN;
+      pairIndex=A.pairIndex;
+    }
+  return *this;
+}
+
+RuleEval::~RuleEval()
+  /*!
+    Destructor
+  */
+{}
+
+size_t
+RuleEval::addSurface(const Geometry::Surface* SPtr,const int SN)
+  /*!
+    Get the index of a surface [adding if new]
+    \param SPtr :: Surface
+    \param SN :: Surface number [unsigned]
+    \return index in SurfVec
+  */
+{
+  for(size_t i=0;i<SurfVec.size();i++)
+    if (SurfVec[i]==SPtr && SurfN[i]==SN)
+      return i;
+
+  SurfVec.push_back(SPtr);
+  SurfN.push_back(SN);
+  return SurfVec.size()-1;
+}
+
+bool
+RuleEval::compileLeaves(const Rule* RPtr,const int typeN)
+  /*!
+    Add the leaves of an intersection/union. Leaves
+    of the same type are joined into the current unit.
+    \param RPtr :: Intersection/Union rule
+    \param typeN :: Type of the current unit
+    \return true on success
+  */
+{
+  for(const int i : {0,1})
+    {
+      const Rule* LPtr=RPtr->leaf(i);
+      if (!LPtr) return 0;
+      const bool flag=(LPtr->type()==typeN) ?
+	compileLeaves(LPtr,typeN) : compileRule(LPtr);
+      if (!flag) return 0;
+    }
+  return 1;
+}
+
+bool
+RuleEval::compileRule(const Rule* RPtr)
+  /*!
+    Add a rule to the flat list
+    \param RPtr :: Rule to add
+    \return true on success / false if not possible
+  */
+{
+  if (!RPtr) return 0;
+
+  const int typeN=RPtr->type();
+  if (typeN==1 || typeN==-1)
+    {
+      const size_t uIndex=Units.size();
+      Units.push_back(evalUnit({typeN,0,0}));
+      if (!compileLeaves(RPtr,typeN))
+	return 0;
+      Units[uIndex].index=Units.size();
+      return 1;
+    }
+
+  const SurfPoint* SPtr=dynamic_cast<const SurfPoint*>(RPtr);
+  if (SPtr)
+    {
+      if (!SPtr->getKey()) return 0;
+      Units.push_back(evalUnit
+		      ({0,SPtr->getSign(),
+			addSurface(SPtr->getKey(),SPtr->getKeyN())}));
+      return 1;
+    }
+
+  const CompGrp* CPtr=dynamic_cast<const CompGrp*>(RPtr);
+  if (CPtr)
+    {
+      // empty complement is always true
+      if (!CPtr->leaf(0))
+	{
+	  Units.push_back(evalUnit({3,1,0}));
+	  return 1;
+	}
+      Units.push_back(evalUnit({2,0,0}));
+      return compileRule(CPtr->leaf(0));
+    }
+
+  const BoolValue* BPtr=dynamic_cast<const BoolValue*>(RPtr);
+  if (BPtr)
+    {
+      const std::map<int,int> emptyMap;
+      Units.push_back(evalUnit({3,(BPtr->isValid(emptyMap)) ? 1 : 0,0}));
+      return 1;
+    }
+  // CompObj etc
+  return 0;
+}
+
+int*
+RuleEval::initState(int* stackV,std::vector<int>& heapV) const
+  /*!
+    Set up the state array for a query [not calculated]
+    \param stackV :: Stack array of size maxStack
+    \param heapV :: Vector used if more surfaces are needed
+    \return state array
+  */
+{
+  if (!compiled)
+    throw ColErr::EmptyContainer("RuleEval not compiled");
+
+  const size_t NS=SurfVec.size();
+  int* stateV(stackV);
+  if (NS>maxStack)
+    {
+      heapV.resize(NS);
+      stateV=heapV.data();
+    }
+  std::fill(stateV,stateV+NS,2);
+  return stateV;
+}
+
+void
+RuleEval::setState(int* stateV,const int SN,const int value) const
+  /*!
+    Set the state of all the units of a surface number
+    \param stateV :: State array
+    \param SN :: Surface number [unsigned]
+    \param value :: -1/1 : fixed side / 3 : free
+  */
+{
+  for(size_t i=0;i<SurfN.size();i++)
+    if (SurfN[i]==SN)
+      stateV[i]=value;
+  return;
+}
+
+int
+RuleEval::setPairFree(const Geometry::Vec3D& Pt,int* stateV,
+		      const bool exFlag,const int SN) const
+  /*!
+    Calculate the side of the sign paired surfaces and
+    set those on Pt as free
+    \param Pt :: Point to test
+    \param stateV :: State array
+    \param exFlag :: Exclude surface SN
+    \param SN :: Surface number [signed]
+    \return number of free surfaces
+  */
+{
+  int cnt(0);
+  for(const size_t i : pairIndex)
+    if (!exFlag || SurfN[i]!=SN)
+      {
+	if (stateV[i]==2)
+	  stateV[i]=SurfVec[i]->side(Pt);
+	if (!stateV[i])
+	  {
+	    setState(stateV,SurfN[i],3);
+	    cnt++;
+	  }
+      }
+  return cnt;
+}
+
+int
+RuleEval::firstFree(const int* stateV) const
+  /*!
+    Find the first free surface
+    \param stateV :: State array
+    \return surface number / 0 if none free
+  */
+{
+  for(size_t i=0;i<SurfN.size();i++)
+    if (stateV[i]==3)
+      return SurfN[i];
+  return 0;
+}
+
+int
+RuleEval::evalState(size_t& index,const Geometry::Vec3D& Pt,
+		    int* stateV) const
+  /*!
+    Evaluate the unit at index with free surfaces as unknown.
+    An intersection/union is decided if any decided part
+    determines it.
+    \param index :: Unit index
+    \param Pt :: Point to test
+    \param stateV :: State array
+    \return 1 : true for all free states / 0 : false for all
+    / -1 : depends on the free states
+  */
+{
+  const evalUnit& EU=Units[index];
+  index++;
+  switch (EU.opType)
+    {
+    case 0:
+      {
+	int& SV=stateV[EU.index];
+	if (SV==2)
+	  SV=SurfVec[EU.index]->side(Pt);
+	if (SV==3) return -1;
+	return (SV*EU.sign>=0) ? 1 : 0;
+      }
+    case 1:
+      {
+	int out(1);
+	while(index<EU.index)
+	  {
+	    const int flag=evalState(index,Pt,stateV);
+	    if (!flag)
+	      {
+		index=EU.index;
+		return 0;
+	      }
+	    if (flag<0) out=-1;
+	  }
+	return out;
+      }
+    case -1:
+      {
+	int out(0);
+	while(index<EU.index)
+	  {
+	    const int flag=evalState(index,Pt,stateV);
+	    if (flag==1)
+	      {
+		index=EU.index;
+		return 1;
+	      }
+	    if (flag<0) out=-1;
+	  }
+	return out;
+      }
+    case 2:
+      {
+	const int flag=evalState(index,Pt,stateV);
+	return (flag<0) ? -1 : 1-flag;
+      }
+    default:
+      return (EU.sign) ? 1 : 0;
+    }
+}
+
+bool
+RuleEval::existsValid(const Geometry::Vec3D& Pt,int* stateV) const
+  /*!
+    Determine if any side of the free surfaces gives a valid
+    point. The first free surface is split and the rule
+    re-evaluated until the result does not depend on the
+    remaining free surfaces.
+    \param Pt :: Point to test
+    \param stateV :: State array [restored on exit]
+    \return true if a valid state exists
+  */
+{
+  size_t index(0);
+  const int flag=evalState(index,Pt,stateV);
+  if (flag>=0) return flag;
+
+  const int SN=firstFree(stateV);
+  bool out(0);
+  for(const int SV : {-1,1})
+    {
+      setState(stateV,SN,SV);
+      if (existsValid(Pt,stateV))
+	{
+	  out=1;
+	  break;
+	}
+    }
+  setState(stateV,SN,3);
+  return out;
+}
+
+bool
+RuleEval::anyDifferent(const RuleEval& A,int* stateA,
+		       const RuleEval& B,int* stateB,
+		       const Geometry::Vec3D& Pt)
+  /*!
+    Determine if any side of the free surfaces gives
+    a different result for the two rules
+    \param A :: First rule
+    \param stateA :: State array of A [restored on exit]
+    \param B :: Second rule
+    \param stateB :: State array of B [restored on exit]
+    \param Pt :: Point to test
+    \return true if a free state splits A and B
+  */
+{
+  size_t index(0);
+  const int flagA=A.evalState(index,Pt,stateA);
+  index=0;
+  const int flagB=B.evalState(index,Pt,stateB);
+  if (flagA>=0 && flagB>=0)
+    return (flagA!=flagB);
+
+  const int SN=(flagA<0) ? A.firstFree(stateA) : B.firstFree(stateB);
+  bool out(0);
+  for(const int SV : {-1,1})
+    {
+      A.setState(stateA,SN,SV);
+      B.setState(stateB,SN,SV);
+      if (anyDifferent(A,stateA,B,stateB,Pt))
+	{
+	  out=1;
+	  break;
+	}
+    }
+  A.setState(stateA,SN,3);
+  B.setState(stateB,SN,3);
+  return out;
+}
+
+bool
+RuleEval::isValid(const Geometry::Vec3D& Pt) const
+  /*!
+    Determine if the point is valid. Sign paired surfaces
+    that the point is on are valid if either side is valid.
+    \param Pt :: Point to test
+    \return true if valid
+  */
+{
+  int stackV[maxStack];
+  std::vector<int> heapV;
+  int* stateV=initState(stackV,heapV);
+
+  setPairFree(Pt,stateV,0,0);
+  return existsValid(Pt,stateV);
+}
+
+bool
+RuleEval::isValid(const Geometry::Vec3D& Pt,const int SN) const
+  /*!
+    Determine if the point is valid with the
+    surface SN taken to be on the side of its sign
+    \param Pt :: Point to test
+    \param SN :: Surface number [signed]
+    \return true if valid
+  */
+{
+  int stackV[maxStack];
+  std::vector<int> heapV;
+  int* stateV=initState(stackV,heapV);
+
+  // SN==0 never matches a side if enumerated
+  if (setPairFree(Pt,stateV,1,SN) && !SN)
+    return 0;
+  if (SN)
+    setState(stateV,std::abs(SN),(SN>0) ? 1 : -1);
+
+  return existsValid(Pt,stateV);
+}
+
+bool
+RuleEval::isSideValid(const Geometry::Vec3D& Pt,const int SN) const
+  /*!
+    Determine if the point is valid with the
+    surface SN on either side
+    \param Pt :: Point to test
+    \param SN :: Surface number [unsigned]
+    \return true if valid
+  */
+{
+  int stackV[maxStack];
+  std::vector<int> heapV;
+  int* stateV=initState(stackV,heapV);
+
+  if (setPairFree(Pt,stateV,1,SN))
+    setState(stateV,SN,3);
+  else if (SN)
+    setState(stateV,std::abs(SN),3);
+
+  return existsValid(Pt,stateV);
+}
+
+bool
+RuleEval::isAnyValid(const Geometry::Vec3D& Pt,
+		     const std::set<int>& SSet) const
+  /*!
+    Determine if the point is valid for any side
+    of the surfaces in SSet
+    \param Pt :: Point to test
+    \param SSet :: Surface numbers [unsigned]
+    \return true if valid
+  */
+{
+  int stackV[maxStack];
+  std::vector<int> heapV;
+  int* stateV=initState(stackV,heapV);
+
+  for(size_t i=0;i<SurfN.size();i++)
+    if (SSet.find(SurfN[i])!=SSet.end())
+      stateV[i]=3;
+  setPairFree(Pt,stateV,0,0);
+
+  return existsValid(Pt,stateV);
+}
+
+bool
+RuleEval::isDifferent(const RuleEval& A,const RuleEval& B,
+		      const Geometry::Vec3D& Pt,
+		      const std::set<int>& SSet,
+		      const int SN)
+  /*!
+    Determine if there is a side of the surfaces in SSet
+    that gives different results for A and B. If SN
+    is set it is taken as -ve in A and +ve in B.
+    Sign paired surfaces are not freed.
+    \param A :: First rule
+    \param B :: Second rule
+    \param Pt :: Point to test
+    \param SSet :: Free surface numbers [unsigned]
+    \param SN :: Split surface number [0 for none]
+    \return true if A and B differ for any state
+  */
+{
+  int stackA[maxStack];
+  int stackB[maxStack];
+  std::vector<int> heapA;
+  std::vector<int> heapB;
+  int* stateA=A.initState(stackA,heapA);
+  int* stateB=B.initState(stackB,heapB);
+
+  for(const int FN : SSet)
+    {
+      A.setState(stateA,FN,3);
+      B.setState(stateB,FN,3);
+    }
+  if (SN)
+    {
+      A.setState(stateA,SN,-1);
+      B.setState(stateB,SN,1);
+    }
+  return anyDifferent(A,stateA,B,stateB,Pt);
+}
+
+void
+RuleEval::write(std::ostream& OX) const
+  /*!
+    Write out the flat rule [debug]
+    \param OX :: Output stream
+  */
+{
+  for(const evalUnit& EU : Units)
+    {
+      switch (EU.opType)
+	{
+	case 0:
+	  OX<<EU.sign*SurfN[EU.index]<<" ";
+	  break;
+	case 1:
+	  OX<<"I["<<EU.index<<"] ";
+	  break;
+	case -1:
+	  OX<<"U["<<EU.index<<"] ";
+	  break;
+	case 2:
+	  OX<<"# ";
+	  break;
+	default:
+	  OX<<((EU.sign) ? "T " : "F ");
+	}
+    }
+  return;
+}
@@ -158,6 +158,9 @@ class Acomp
   
   int getSinglet() const;
   const Acomp* itemC(const size_t) const;
+  /// Access units
+  const std::set<int,AcompTools::unitsLessOrder>& getUnits() const
+    { return Units; }
 
   size_t countComponents() const;
   std::pair<size_t,size_t> size() const;
@@ -22,10 +22,13 @@
 #ifndef Algebra_h
 #define Algebra_h
 
+class Rule;
+class HeadRule;
 
 namespace MonteCarlo
 {
-
+  class Object;
+  
 /*!
   \class  Algebra
   \brief Computes Boolean algebra for simplification
@@ -46,6 +49,12 @@ class Algebra
   Acomp F;                              ///< Factor
 
   std::vector<std::pair<int,int>> ImplicateVec;   ///< implicate vector
+
+  int getLiteral(const int);
+  Acomp makeComp(const Rule*,const std::map<int,Object*>*);
+  void makeRuleList(const Acomp&,const std::map<int,int>&,
+		     std::vector<Rule*>&) const;
+  Rule* makeRule(const Acomp&,const std::map<int,int>&) const;
   
  public:
 
@@ -81,6 +90,8 @@ class Algebra
   void makeCNF() { F.makeCNFobject(); }  ///< assessor to makeCNFobj
   std::pair<Algebra,Algebra> algDiv(const Algebra&) const;
   int setFunctionObjStr(const std::string&);
+  int setFunctionObj(const Rule*);
+  int setFunctionObj(const Rule*,const std::map<int,Object*>&);
   int setFunction(const std::string&);
   int setFunction(const Acomp&);
 
@@ -95,6 +106,7 @@ class Algebra
   std::string display() const;
   std::ostream& write(std::ostream&) const;
   std::string writeMCNPX() const;
+  HeadRule writeHeadRule() const;
 
   size_t countLiterals() const;
 
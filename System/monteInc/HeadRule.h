@@ -26,10 +26,12 @@ class Token;
 class Rule;
 class CompGrp;
 class SurfPoint;
+class RuleEval;
 
 namespace Geometry
 {
   class Surface;
+  class BBox;
   struct interPoint;
 }
 
@@ -56,6 +58,7 @@ class HeadRule
   ///< set of surfaces with opposite signs
   std::set<const Geometry::Surface*> signPairedSurf;   
   std::set<const Geometry::Surface*> surfSet;
+  RuleEval* EvalPtr;                 ///< Compiled form [if possible]
   
   Rule* findKey(const int); 
   void removeItem(const Rule*);
@@ -66,6 +69,10 @@ class HeadRule
   const SurfPoint* findSurf(const int) const;
 
   void calcSurfaces();
+  void clearEval();
+
+  static Geometry::BBox calcRuleBox(const Rule*);
+  static Geometry::BBox calcSurfBox(const Geometry::Surface*,const int);
   
  public:
 
@@ -93,6 +100,8 @@ class HeadRule
   
   /// access main rule
   const Rule* getTopRule() const { return HeadNode; }
+  /// access compiled rule [null if not populated/possible]
+  const RuleEval* getEval() const { return EvalPtr; }
 
   void populateSurf();
   void reset();
@@ -115,6 +124,9 @@ class HeadRule
   bool isLineValid(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
   bool isZeroVolume() const;
 
+  Geometry::BBox calcBoundBox() const;
+  bool isBoundPolytope() const;
+
   std::set<int> getPairedSurf() const;
   
   std::set<int> surfValid(const Geometry::Vec3D&) const;
@@ -184,6 +196,7 @@ class HeadRule
   int substituteSurf(const ModelSupport::surfRegister&,
 		     const int,const int);
   int substituteSurf(const int,const int,const Geometry::Surface*);
+  int substituteSurf(const std::map<int,int>&);
   void removeCommon();
   void removeComplement();
 
@@ -26,6 +26,7 @@ class Token;
 namespace Geometry
 {
   struct interPoint;
+  class BBox;
   class Plane;
   template<typename T> class M3;
 }
@@ -72,12 +73,21 @@ class Object
   
   HeadRule HRule;           ///< Top rule
 
-  Geometry::Vec3D COM;      ///< Centre of mass 
+  mutable bool comValid;          ///< Centre of mass calculated
+  mutable Geometry::Vec3D COM;    ///< Centre of mass [cached]
+
+  mutable bool boxValid;            ///< Bounding box calculated
+  mutable Geometry::Vec3D boxLow;   ///< Bounding box low corner
+  mutable Geometry::Vec3D boxHigh;  ///< Bounding box high corner
+
+  bool bvhFlag;                ///< Box held in a cell BVH
+  static size_t bvhChange;     ///< Box changes of objects in a BVH
    
   int checkSurfaceValid(const Geometry::Vec3D&,const Geometry::Vec3D&) const;
   /// Calc in/out 
   int calcInOut(const int,const int) const;
   void clearValid();
+  void calcBoundBox() const;
   
  protected:
   
@@ -173,6 +183,7 @@ class Object
   void addIntersection(const HeadRule&);
   int removeSurface(const int);        
   int substituteSurf(const int,const int,Geometry::Surface*);  
+  int substituteSurf(const std::map<int,int>&);
   void makeComplement();
 
   bool hasSurface(const int) const;
@@ -184,6 +195,16 @@ class Object
   std::pair<double,double> getElecStep() const
     { return std::pair<double,double>(elecMinStep,elecMaxStep); }  
 
+  /// Bounding box calculated
+  bool hasBoundBox() const { return boxValid; }
+  void clearBoundBox();
+  /// Set if the box is held in a cell BVH
+  void setBVH(const bool F) { bvhFlag=F; }
+  /// Number of box changes of objects held in a BVH
+  static size_t getBVHChange() { return bvhChange; }
+  Geometry::BBox getBoundBox() const;
+  bool inBoundBox(const Geometry::Vec3D&) const;
+
   int isValid(const Geometry::Vec3D&) const;            
   int isValid(const Geometry::Vec3D&,const int) const;
   int isSideValid(const Geometry::Vec3D&,const int) const;            
@@ -245,8 +266,9 @@ class Object
 		     const Geometry::Vec3D&) const;
 
 
-  /// acessor to forward 
-  Geometry::Vec3D getCofM() const { return COM; }
+  const Geometry::Vec3D& getCofM() const;
+  /// Has the centre of mass been calculated
+  bool hasCofM() const { return comValid; }
   // OUTPUT
   std::string cellCompStr() const;
   std::vector<Token> cellVec() const;
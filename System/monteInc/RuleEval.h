@@ -0,0 +1,115 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   monteInc/RuleEval.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef RuleEval_h
+#define RuleEval_h
+
+class Rule;
+
+namespace Geometry
+{
+  class Surface;
+}
+
+/*!
+  \class RuleEval
+  \brief Flat compiled form of a Rule tree for point tests
+  \author S.Ansell
+  \version 1.0
+  \date October 2026
+
+  The rule tree is flattened into a prefix list of
+  units. Nested intersections/unions of the same type are
+  joined into a single n-ary unit with the index of the end
+  of the sub-tree to allow short-circuit jumps. Each distinct
+  surface is held once so side() is called at most once
+  per query. Trees with CompObj or unset surfaces are not
+  compiled.
+
+  Surfaces that can be on either side (e.g. sign paired 
+  surfaces that the point is on) are held as free. The rule is 
+  evaluated with three states and only split on a free
+  surface if the result depends on it.
+*/
+
+class RuleEval
+{
+ private:
+
+  /// Unit of the flat rule
+  struct evalUnit
+  {
+    int opType;           ///< 0 surf : 1 inter : -1 union : 2 comp : 3 bool
+    int sign;             ///< surface sign / bool value
+    size_t index;         ///< surface index / end of sub-tree
+  };
+
+  /// Surfaces held on the stack during a query
+  static constexpr size_t maxStack=64;
+  
+  bool compiled;                                 ///< Rule compiled
+  std::vector<evalUnit> Units;                   ///< Flat rule
+  std::vector<const Geometry::Surface*> SurfVec; ///< Distinct surfaces
+  std::vector<int> SurfN;                        ///< Surface numbers
+  std::vector<size_t> pairIndex;                 ///< Sign paired surfaces
+
+  size_t addSurface(const Geometry::Surface*,const int);
+  bool compileRule(const Rule*);
+  bool compileLeaves(const Rule*,const int);
+
+  int* initState(int*,std::vector<int>&) const;
+  void setState(int*,const int,const int) const;
+  int setPairFree(const Geometry::Vec3D&,int*,const bool,const int) const;
+  int firstFree(const int*) const;
+  int evalState(size_t&,const Geometry::Vec3D&,int*) const;
+  bool existsValid(const Geometry::Vec3D&,int*) const;
+  static bool anyDifferent(const RuleEval&,int*,const RuleEval&,int*,
+			   const Geometry::Vec3D&);
+
+ public:
+
+  RuleEval(const Rule*,const std::set<const Geometry::Surface*>&);
+  RuleEval(const RuleEval&);
+  RuleEval& operator=(const RuleEval&);
+  ~RuleEval();
+
+  /// Rule was flattened
+  bool isCompiled() const { return compiled; }
+  /// Number of distinct surfaces
+  size_t getNSurf() const { return SurfVec.size(); }
+  /// Number of units
+  size_t getNUnits() const { return Units.size(); }
+
+  bool isValid(const Geometry::Vec3D&) const;
+  bool isValid(const Geometry::Vec3D&,const int) const;
+  bool isSideValid(const Geometry::Vec3D&,const int) const;
+  bool isAnyValid(const Geometry::Vec3D&,const std::set<int>&) const;
+
+  static bool isDifferent(const RuleEval&,const RuleEval&,
+			  const Geometry::Vec3D&,const std::set<int>&,
+			  const int);
+
+  void write(std::ostream&) const;
+};
+
+std::ostream& operator<<(std::ostream&,const RuleEval&);
+
+#endif
@@ -33,6 +33,8 @@
 #include <algorithm>
 #include <memory>
 #include <random>
+#include <functional>
+#include <tuple>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -44,6 +46,7 @@
 #include "Random.h"
 #include "support.h"
 #include "Vec3D.h"
+#include "BBox.h"
 #include "Surface.h"
 #include "Quadratic.h"
 #include "Plane.h"
@@ -56,6 +59,8 @@
 #include "groupRange.h"
 #include "objectGroups.h"
 #include "Simulation.h"
+#include "SimTrack.h"
+#include "threadSupport.h"
 #include "localRotate.h"
 #include "activeUnit.h"
 #include "activeFluxPt.h"
@@ -211,65 +216,166 @@ ActivationSource::rotate(const localRotate& LR)
 void
 ActivationSource::createFluxVolumes(const Simulation& System)
  /*!
-   Process a number of points to get the volume
+   Process a number of points to get the volume.
+   Points are only sampled within the union of the bounding boxes
+   of the flux cells (clipped to the source box). A box is chosen
+   in proportion to its volume and a point is only kept if no
+   earlier box also holds it, so kept points are uniform in the
+   union and each draw carries the weight sumV/nTotal.
+   A fixed number of streams with independent generators are run
+   over the threads and merged in stream order, so the result
+   does not depend on the thread count.
    \param System :: Simulation to use
  */
 {
   ELog::RegMethod RegA("ActivationSource","createFluxVolumes");
 
+  // number of independent random streams / draws per stream per round
+  constexpr size_t NStream(64);
+  constexpr size_t NChunk(1024);
+
   nTotal=0;
   size_t index=0;
   fluxPt.clear();
+  volCorrection.clear();
 
   ELog::EM<<"Volume == "<<ABoxPt<<" : "<<BBoxPt<<ELog::endDiag;
-  const Geometry::Vec3D BDiff(BBoxPt-ABoxPt);
-  const double xStep(BDiff[0]);
-  const double yStep(BDiff[1]);
-  const double zStep(BDiff[2]);
-  MonteCarlo::Object* cellPtr(0);
+  const Geometry::BBox SampleBox
+    (Geometry::Vec3D(std::min(ABoxPt[0],BBoxPt[0]),
+		     std::min(ABoxPt[1],BBoxPt[1]),
+		     std::min(ABoxPt[2],BBoxPt[2])),
+     Geometry::Vec3D(std::max(ABoxPt[0],BBoxPt[0]),
+		     std::max(ABoxPt[1],BBoxPt[1]),
+		     std::max(ABoxPt[2],BBoxPt[2])));
+
+  // boxes of the flux cells : volume cumulative sum
+  std::vector<Geometry::BBox> CBox;
+  std::vector<double> cumV;
+  double sumV(0.0);
+  for(const std::map<int,activeUnit>::value_type& CA : cellFlux)
+    {
+      const MonteCarlo::Object* OPtr=System.findObject(CA.first);
+      if (OPtr)
+	{
+	  const Geometry::BBox BX=OPtr->getBoundBox()*SampleBox;
+	  const double V=(BX.isEmpty()) ? 0.0 : BX.volume();
+	  if (V>Geometry::zeroTol)
+	    {
+	      CBox.push_back(BX);
+	      sumV+=V;
+	      cumV.push_back(sumV);
+	    }
+	}
+    }
+  if (CBox.empty())
+    throw ColErr::EmptyContainer("Flux cells in source box");
+
+  // earlier boxes that overlap each box
+  std::vector<std::vector<size_t>> overLap(CBox.size());
+  for(size_t i=1;i<CBox.size();i++)
+    for(size_t j=0;j<i;j++)
+      if (CBox[i].intersects(CBox[j]))
+	overLap[i].push_back(j);
+
+  ELog::EM<<"Sample boxes == "<<CBox.size()<<" volume fraction == "
+	  <<sumV/SampleBox.volume()<<ELog::endDiag;
+
+  std::vector<std::mt19937> Gen;
+  Gen.reserve(NStream);
+  for(size_t i=0;i<NStream;i++)
+    Gen.emplace_back(static_cast<std::mt19937::result_type>(i+1));
+  std::vector<MonteCarlo::Object*> cellPtr(NStream,nullptr);
+
+  // hits in each stream : draw number / cell / point
+  typedef std::tuple<size_t,int,Geometry::Vec3D> hitTYPE;
+  std::vector<std::vector<hitTYPE>> Hits(NStream);
+
   size_t reportScore(nPoints*1);
   ELog::EM<<"Report == "<<reportScore<<ELog::endDiag;
   while(index<nPoints)
     {
-      Geometry::Vec3D testPt(xStep*Random::rand(),
-			     yStep*Random::rand(),
-			     zStep*Random::rand());
-      testPt+=ABoxPt;
-
-      cellPtr=System.findCell(testPt,cellPtr);
-      if (!cellPtr)
-	throw ColErr::InContainerError<Geometry::Vec3D>
-	  (testPt,"Point not in cell");
-
-      // test for Material / cellFlux / volume.
-      if (!cellPtr->isVoid())
+      threadSupport::parallelLoop
+	(System.getThreads(),NStream,
+	 [&](const size_t SN)
+	 {
+	   std::mt19937& gen(Gen[SN]);
+	   std::uniform_real_distribution<double> RNG(0.0,1.0);
+	   std::vector<hitTYPE>& HX(Hits[SN]);
+	   HX.clear();
+	   ModelSupport::SimTrack::Instance().setCell(&System,0);
+	   for(size_t i=0;i<NChunk;i++)
+	     {
+	       const size_t BI=std::min
+		 (CBox.size()-1,static_cast<size_t>
+		  (std::upper_bound(cumV.begin(),cumV.end(),RNG(gen)*sumV)-
+		   cumV.begin()));
+	       const Geometry::BBox& BX=CBox[BI];
+	       const Geometry::Vec3D& LPt=BX.getLow();
+	       const Geometry::Vec3D BDiff(BX.getHigh()-LPt);
+	       const Geometry::Vec3D testPt
+		 (LPt[0]+BDiff[0]*RNG(gen),
+		  LPt[1]+BDiff[1]*RNG(gen),
+		  LPt[2]+BDiff[2]*RNG(gen));
+	       // only the first box holding the point keeps it
+	       bool keep(1);
+	       for(const size_t j : overLap[BI])
+		 if (CBox[j].isValid(testPt))
+		   {
+		     keep=0;
+		     break;
+		   }
+	       if (!keep) continue;
+
+	       cellPtr[SN]=System.findCell(testPt,cellPtr[SN]);
+	       if (!cellPtr[SN])
+		 throw ColErr::InContainerError<Geometry::Vec3D>
+		   (testPt,"Point not in cell");
+
+	       // test for Material / cellFlux / volume.
+	       if (!cellPtr[SN]->isVoid())
+		 {
+		   const int cellN=cellPtr[SN]->getName();
+		   if (cellFlux.find(cellN)!=cellFlux.end())
+		     HX.emplace_back(i,cellN,testPt);
+		 }
+	     }
+	 });
+
+      // merge in stream order : stop at the nPoints hit
+      for(size_t SN=0;SN<NStream && index<nPoints;SN++)
 	{
-	  const int cellN=cellPtr->getName();
-          if (cellFlux.find(cellN)!=cellFlux.end())
-            {
-              std::map<int,double>::iterator mc=
-                volCorrection.find(cellN);
-              if (mc==volCorrection.end())
-                volCorrection.emplace(cellN,1.0);
-              else
-                mc->second+=1.0;
-              fluxPt.push_back(activeFluxPt(cellN,testPt));
-              index++;
-            }
-        }
-      nTotal++;
-      if (!(nTotal % reportScore))
+	  size_t nDraw(NChunk);
+	  for(const auto& [drawN,cellN,Pt] : Hits[SN])
+	    {
+	      std::map<int,double>::iterator mc=
+		volCorrection.find(cellN);
+	      if (mc==volCorrection.end())
+		volCorrection.emplace(cellN,1.0);
+	      else
+		mc->second+=1.0;
+	      fluxPt.push_back(activeFluxPt(cellN,Pt));
+	      if (++index==nPoints)
+		{
+		  nDraw=drawN+1;
+		  break;
+		}
+	    }
+	  nTotal+=nDraw;
+	}
+      if (nTotal>=reportScore)
         {
-          ELog::EM<<"Ntotal/nPoints == "<<nTotal<<":"<<nPoints<<" found="<<index<<ELog::endDiag;
-          reportScore*=2;
+          ELog::EM<<"Ntotal/nPoints == "<<nTotal<<":"<<nPoints
+		  <<" found="<<index<<ELog::endDiag;
+	  while(reportScore<=nTotal)
+	    reportScore*=2;
         }
     }
   ELog::EM<<"FINAL nPoints/Ntotal == "<<nPoints<<":"<<nTotal<<ELog::endDiag;
 
   // correct volumes by correct count
-  // volcorrection has good count : divide by total count and multiply by total volume
-  const double boxVol=
-    BDiff.volume()/static_cast<double>(nTotal);
+  // volcorrection has good count : divide by total count and
+  // multiply by total sampled box volume
+  const double boxVol=sumV/static_cast<double>(nTotal);
 
   // normalisze cellFlux
   // The volume self cancels since flux was per volume and this is not:
@@ -279,7 +385,7 @@ ActivationSource::createFluxVolumes(const Simulation& System)
     {
       std::map<int,double>::const_iterator mc=
 	volCorrection.find(CA.first);
-      if (mc->second>Geometry::zeroTol)
+      if (mc!=volCorrection.end() && mc->second>Geometry::zeroTol)
 	CA.second.normalize(static_cast<double>(nPoints)/mc->second,
 			    boxVol*mc->second);
     }
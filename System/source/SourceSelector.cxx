@@ -61,7 +61,6 @@
 #include "Material.h"
 #include "inputSupport.h"
 #include "SourceCreate.h"
-#include "vertexCalc.h"
 #include "inputSupport.h"
 #include "SourceBase.h"
 #include "World.h"
@@ -105,8 +104,7 @@ getCellsContainingZaid(Simulation& System,
 	  const MonteCarlo::Material* cellMat=OPtr->getMatPtr();
 	  if (cellMat->hasZaid(zaid,0,0))
 	    {
-	      const Geometry::Vec3D CofM=
-		ModelSupport::calcCOFM(*OPtr);
+	      const Geometry::Vec3D& CofM=OPtr->getCofM();
 	      if (OPtr->isValid(CofM))
 		FissionVec.push_back(CofM);
 	    }
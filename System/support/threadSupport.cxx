@@ -0,0 +1,114 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   support/threadSupport.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <cstddef>
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <exception>
+
+#include "threadSupport.h"
+
+namespace threadSupport
+{
+
+size_t
+threadCount(const size_t nThreads,const size_t nItems)
+  /*!
+    Determine the number of threads to use for a loop
+    \param nThreads :: Requested threads [0 : hardware count]
+    \param nItems :: Number of items in the loop
+    \return threads to use [1 for serial]
+  */
+{
+  size_t N(nThreads);
+  if (!N)
+    {
+      N=static_cast<size_t>(std::thread::hardware_concurrency());
+      if (!N) N=1;
+    }
+  if (N>nItems) N=nItems;
+  return (N) ? N : 1;
+}
+
+void
+parallelLoop(const size_t nThreads,const size_t nItems,
+	     const std::function<void(const size_t)>& Func)
+  /*!
+    Run Func(i) for i in [0,nItems) over a number of threads.
+    Each index is taken from a shared counter so work is
+    balanced, the order of calls is not defined. Func must
+    only write to data owned by index i. The first exception
+    thrown is re-thrown in the calling thread after all
+    threads have finished.
+    \param nThreads :: Requested threads [0 : hardware count]
+    \param nItems :: Number of items
+    \param Func :: Function to call on each index
+  */
+{
+  const size_t NT=threadCount(nThreads,nItems);
+  if (NT<=1)
+    {
+      for(size_t i=0;i<nItems;i++)
+	Func(i);
+      return;
+    }
+
+  std::atomic<size_t> nextIndex(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr firstError;
+  std::mutex errorLock;
+
+  auto worker=[&]()
+    {
+      size_t i;
+      while(!failed && (i=nextIndex++)<nItems)
+	{
+	  try
+	    {
+	      Func(i);
+	    }
+	  catch(...)
+	    {
+	      std::lock_guard<std::mutex> Guard(errorLock);
+	      if (!firstError)
+		firstError=std::current_exception();
+	      failed=true;
+	    }
+	}
+    };
+
+  std::vector<std::thread> Workers;
+  Workers.reserve(NT-1);
+  for(size_t i=1;i<NT;i++)
+    Workers.emplace_back(worker);
+  worker();
+  for(std::thread& TH : Workers)
+    TH.join();
+
+  if (firstError)
+    std::rethrow_exception(firstError);
+  return;
+}
+
+}  // NAMESPACE threadSupport
@@ -0,0 +1,199 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   support/vtiWriter.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <map>
+#include <string>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <cstdint>
+#include <bit>
+#include <format>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "Vec3D.h"
+#include "vtiWriter.h"
+
+namespace StrFunc
+{
+
+template<typename OutT,typename InT>
+static std::vector<char>
+transposeBlock(const std::array<size_t,3>& nPts,
+	       const std::vector<InT>& In)
+  /*!
+    Convert a Z-fastest array into an X-fastest raw block
+    \param nPts :: Number of x/y/z points
+    \param In :: Input data [Z fastest]
+    \return raw bytes of OutT
+  */
+{
+  const size_t nX(nPts[0]);
+  const size_t nY(nPts[1]);
+  const size_t nZ(nPts[2]);
+  std::vector<OutT> Out(nX*nY*nZ);
+  size_t index(0);
+  for(size_t i=0;i<nX;i++)
+    for(size_t j=0;j<nY;j++)
+      for(size_t k=0;k<nZ;k++)
+	{
+	  if constexpr (std::is_same_v<OutT,InT>)
+	    Out[(k*nY+j)*nX+i]=In[index++];
+	  else if constexpr (std::is_integral_v<OutT>)
+	    Out[(k*nY+j)*nX+i]=static_cast<OutT>(std::round(In[index++]));
+	  else
+	    Out[(k*nY+j)*nX+i]=static_cast<OutT>(In[index++]);
+	}
+  std::vector<char> Block(Out.size()*sizeof(OutT));
+  std::memcpy(Block.data(),Out.data(),Block.size());
+  return Block;
+}
+
+vtiWriter::vtiWriter(const std::array<size_t,3>& N,
+		     const Geometry::Vec3D& OPt,
+		     const Geometry::Vec3D& Step) :
+  nPts(N),Origin(OPt),Spacing(Step)
+  /*!
+    Constructor
+    \param N :: Number of x/y/z points
+    \param OPt :: Centre of the first point
+    \param Step :: Spacing in x/y/z
+  */
+{}
+
+void
+vtiWriter::addArray(const std::string& Name,
+		    const std::vector<int>& Data)
+  /*!
+    Add an integer array [Int32]
+    \param Name :: Array name
+    \param Data :: Data [Z fastest]
+  */
+{
+  ELog::RegMethod RegA("vtiWriter","addArray(int)");
+
+  if (Data.size()!=nItems())
+    throw ColErr::MisMatch<size_t>(Data.size(),nItems(),"Data/nPts");
+
+  Names.push_back(Name);
+  IntFlag.push_back(1);
+  Block.push_back(transposeBlock<int32_t>(nPts,Data));
+  return;
+}
+
+void
+vtiWriter::addArray(const std::string& Name,
+		    const std::vector<double>& Data,
+		    const bool intFlag)
+  /*!
+    Add a double array [Float32 or rounded Int32]
+    \param Name :: Array name
+    \param Data :: Data [Z fastest]
+    \param intFlag :: write as Int32
+  */
+{
+  ELog::RegMethod RegA("vtiWriter","addArray(double)");
+
+  if (Data.size()!=nItems())
+    throw ColErr::MisMatch<size_t>(Data.size(),nItems(),"Data/nPts");
+
+  Names.push_back(Name);
+  IntFlag.push_back(intFlag);
+  Block.push_back((intFlag) ?
+		  transposeBlock<int32_t>(nPts,Data) :
+		  transposeBlock<float>(nPts,Data));
+  return;
+}
+
+void
+vtiWriter::write(std::ostream& OX) const
+  /*!
+    Write out the header and the appended blocks.
+    Each block is preceeded by its UInt64 byte count.
+    \param OX :: Output stream [binary]
+  */
+{
+  const std::string extent=std::format("0 {} 0 {} 0 {}",
+				       nPts[0]-1,nPts[1]-1,nPts[2]-1);
+  const std::string byteOrder=(std::endian::native==std::endian::little) ?
+    "LittleEndian" : "BigEndian";
+
+  OX<<"<?xml version=\"1.0\"?>\n"
+    <<"<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\""
+    <<byteOrder<<"\" header_type=\"UInt64\">\n"
+    <<"  <ImageData WholeExtent=\""<<extent<<"\" Origin=\""
+    <<std::format("{:.9g} {:.9g} {:.9g}",Origin.X(),Origin.Y(),Origin.Z())
+    <<"\" Spacing=\""
+    <<std::format("{:.9g} {:.9g} {:.9g}",
+		  Spacing.X(),Spacing.Y(),Spacing.Z())<<"\">\n"
+    <<"    <Piece Extent=\""<<extent<<"\">\n";
+  if (Names.empty())
+    OX<<"      <PointData>\n";
+  else
+    OX<<"      <PointData Scalars=\""<<Names.front()<<"\">\n";
+
+  uint64_t offset(0);
+  for(size_t i=0;i<Names.size();i++)
+    {
+      OX<<"        <DataArray type=\""
+	<<((IntFlag[i]) ? "Int32" : "Float32")
+	<<"\" Name=\""<<Names[i]<<"\" format=\"appended\" offset=\""
+	<<offset<<"\"/>\n";
+      offset+=sizeof(uint64_t)+Block[i].size();
+    }
+  OX<<"      </PointData>\n"
+    <<"    </Piece>\n"
+    <<"  </ImageData>\n"
+    <<"  <AppendedData encoding=\"raw\">\n   _";
+  for(const std::vector<char>& B : Block)
+    {
+      const uint64_t nBytes(B.size());
+      OX.write(reinterpret_cast<const char*>(&nBytes),sizeof(nBytes));
+      OX.write(B.data(),static_cast<std::streamsize>(nBytes));
+    }
+  OX<<"\n  </AppendedData>\n</VTKFile>\n";
+  return;
+}
+
+void
+vtiWriter::write(const std::string& FName) const
+  /*!
+    Write out to a file
+    \param FName :: filename [empty for no output]
+  */
+{
+  if (FName.empty()) return;
+  std::ofstream OX(FName.c_str(),std::ios::binary);
+  write(OX);
+  OX.close();
+  return;
+}
+
+}  // NAMESPACE StrFunc
@@ -0,0 +1,43 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   supportInc/threadSupport.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef threadSupport_h
+#define threadSupport_h
+
+/*!
+  \namespace threadSupport
+  \brief Simple work sharing over std::thread
+  \author S. Ansell
+  \date October 2026
+  \version 1.0
+*/
+
+namespace threadSupport
+{
+
+size_t threadCount(const size_t,const size_t);
+
+void parallelLoop(const size_t,const size_t,
+		  const std::function<void(const size_t)>&);
+
+}  // NAMESPACE threadSupport
+
+#endif
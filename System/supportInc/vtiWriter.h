@@ -0,0 +1,67 @@
+/*********************************************************************
+  CombLayer : MCNP(X) Input builder
+
+ * File:   supportInc/vtiWriter.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ****************************************************************************/
+#ifndef StrFunc_vtiWriter_h
+#define StrFunc_vtiWriter_h
+
+namespace StrFunc
+{
+
+/*!
+  \class vtiWriter
+  \brief Write a VTK XML ImageData file with raw appended blocks
+  \author S. Ansell
+  \version 1.0
+  \date October 2026
+
+  Arrays are given Z-fastest [as multiData] and are
+  stored X-fastest [VTK order] as Int32 or Float32.
+ */
+class vtiWriter
+{
+ private:
+
+  std::array<size_t,3> nPts;             ///< Number x/y/z points
+  Geometry::Vec3D Origin;                ///< Centre of first point
+  Geometry::Vec3D Spacing;               ///< Point spacing
+
+  std::vector<std::string> Names;        ///< Array names
+  std::vector<bool> IntFlag;             ///< Array is Int32
+  std::vector<std::vector<char>> Block;  ///< Raw data [X fastest]
+
+  size_t nItems() const { return nPts[0]*nPts[1]*nPts[2]; }
+
+ public:
+
+  vtiWriter(const std::array<size_t,3>&,
+	    const Geometry::Vec3D&,const Geometry::Vec3D&);
+
+  void addArray(const std::string&,const std::vector<int>&);
+  void addArray(const std::string&,const std::vector<double>&,
+		const bool =0);
+
+  void write(std::ostream&) const;
+  void write(const std::string&) const;
+};
+
+}
+
+#endif
@@ -132,6 +132,27 @@ sswTally::renumberSurf(const int oldN,const int newN)
   return;
 }
 
+void
+sswTally::renumberSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in a single pass so that a
+    new number that is also an old number is not changed twice
+    \param RMap :: Map of old : new surface numbers
+  */
+{
+  ELog::RegMethod RegA("sswTally","renumberSurf(map)");
+
+  std::transform(surfList.begin(),surfList.end(),surfList.begin(),
+		 [&RMap](const int x) -> int
+		 {
+		   std::map<int,int>::const_iterator mc=RMap.find(x);
+		   if (mc!=RMap.end()) return mc->second;
+		   mc=RMap.find(-x);
+		   return (mc!=RMap.end()) ? -mc->second : x;
+		 });
+  return;
+}
+
 void
 sswTally::write(std::ostream& OX) const
   /*!
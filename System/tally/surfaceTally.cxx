@@ -262,6 +262,32 @@ surfaceTally::renumberSurf(const int oldN,const int newN)
   return;
 }
 
+void
+surfaceTally::renumberSurf(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in a single pass so that a
+    new number that is also an old number is not changed twice
+    \param RMap :: Map of old : new surface numbers
+   */
+{
+  ELog::RegMethod RegA("surfaceTally","renumberSurf(map)");
+
+  auto newSurf=[&RMap](const int x) -> int
+    {
+      std::map<int,int>::const_iterator mc=RMap.find(x);
+      if (mc!=RMap.end()) return mc->second;
+      mc=RMap.find(-x);
+      return (mc!=RMap.end()) ? -mc->second : x;
+    };
+  
+  SurfFlag.changeItem(RMap);
+  std::transform(SurfList.begin(),SurfList.end(),
+		 SurfList.begin(),newSurf);
+  std::transform(FSfield.begin(),FSfield.end(),
+		 FSfield.begin(),newSurf);
+  return;
+}
+
 
 void
 surfaceTally::write(std::ostream& OX) const
@@ -111,6 +111,8 @@ class Tally
   virtual void renumberCell(const int,const int) {}
   /// Renumber [not normally required]
   virtual void renumberSurf(const int,const int) {}
+  /// Renumber from a map in one pass [not normally required]
+  virtual void renumberSurf(const std::map<int,int>&) {}
   /// make a group sum into single units
   virtual int makeSingle() { return 0; }
 
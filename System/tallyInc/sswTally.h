@@ -51,6 +51,7 @@ class sswTally : public Tally
 
   void addSurfaces(const std::vector<int>&);
   void renumberSurf(const int,const int) override;
+  void renumberSurf(const std::map<int,int>&) override;
 
   void write(std::ostream&) const override;
 };
@@ -65,6 +65,7 @@ class surfaceTally : public Tally
     
     void renumberCell(const int,const int) override;
     void renumberSurf(const int,const int) override;
+    void renumberSurf(const std::map<int,int>&) override;
 
     void write(std::ostream&) const override;
     
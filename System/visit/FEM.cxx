@@ -32,6 +32,7 @@
 #include <vector>
 #include <memory>
 #include <array>
+#include <functional>
 
 #include "FileReport.h"
 #include "NameStack.h"
@@ -53,7 +54,10 @@
 #include "LineTrack.h"
 #include "dataSlice.h"
 #include "multiData.h"
+#include "vtiWriter.h"
 #include "FEMdatabase.h"
+#include "threadSupport.h"
+#include "visitSupport.h"
 #include "FEM.h"
 
 FEM::FEM() :
@@ -224,9 +228,9 @@ FEM::getKUnit(const size_t posIndex,
 void
 FEM::populateLine(const Simulation& System)
   /*!
-    The big population call with lines
+    The big population call with lines. The lines are
+    split over System.getThreads() threads
     \param System :: Simulation system
-    \param Active :: Active set of cells to use (ranged)
    */
 {
   ELog::RegMethod RegA("FEM","populateLine");
@@ -257,12 +261,11 @@ FEM::populateLine(const Simulation& System)
     (IMax==1) ? (YStep*XStep).unit()*XYZ[IMax] :
     (XStep*YStep).unit()*XYZ[IMax];
 
-  for(size_t i=0;i<nA;i++)
-    for(size_t j=0;j<nB;j++)
+  // each line only writes its own mesh units
+  auto lineFunc=[&](const size_t lineIndex)
       { 
-	std::vector<double> distVec;
-	std::vector<MonteCarlo::Object*> cellVec;
-	
+	const size_t i=lineIndex/nB;
+	const size_t j=lineIndex % nB;
 	const Geometry::Vec3D aVec=Origin+
 	  XStep*(static_cast<double>(i)+0.5)+
 	  YStep*(static_cast<double>(j)+0.5);
@@ -284,49 +287,81 @@ FEM::populateLine(const Simulation& System)
 		  getMeshUnit(IMax,index++,i,j)=mValue;
 	      }
 	  }
-      }
+      };
+
+  threadSupport::parallelLoop(System.getThreads(),nA*nB,lineFunc);
   return;
 }
 
+std::vector<Geometry::Vec3D>
+FEM::populateRow(const Simulation& System,
+		 const size_t i,const size_t j)
+  /*!
+    Populate a single row of constant i,j along z.
+    The cells are found from a track along the row
+    [visitSupport::rowCells].
+    \param System :: Simulation system
+    \param i :: x index
+    \param j :: y index
+    \return points with no cell
+   */
+{
+  ELog::RegMethod RegA("FEM","populateRow");
+
+  const sliceUnit<int> MAT=matMesh.get();
+
+  const Geometry::Vec3D rowPt=Origin+
+    Geometry::Vec3D
+    (XYZ[0]*(static_cast<double>(i)+0.5)/static_cast<double>(nPts[0]),
+     XYZ[1]*(static_cast<double>(j)+0.5)/static_cast<double>(nPts[1]),
+     0.0);
+  const Geometry::Vec3D rowVec(0,0,XYZ[2]);
+
+  std::vector<MonteCarlo::Object*> cellVec;
+  visitSupport::rowCells(System,rowPt,rowVec,nPts[2],cellVec);
+
+  std::vector<Geometry::Vec3D> zeroPts;
+  for(size_t k=0;k<nPts[2];k++)
+    {
+      if (cellVec[k])
+	MAT[i][j][k]=cellVec[k]->getMatID();
+      else
+	{
+	  MAT[i][j][k]=0;
+	  zeroPts.push_back
+	    (rowPt+rowVec*((static_cast<double>(k)+0.5)/
+			   static_cast<double>(nPts[2])));
+	}
+    }
+  return zeroPts;
+}
+
 void
 FEM::populatePoint(const Simulation& System)
   /*!
-    The big population call
+    The big population call. Rows along z are split
+    over System.getThreads() threads. Points with no 
+    cell are reported in mesh order.
     \param System :: Simulation system
    */
 {
   ELog::RegMethod RegA("FEM","populatePoint");
 
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
-
-  const sliceUnit<int> MAT=matMesh.get();
-  
   if (nPts[0]>=1 && nPts[1]>=1 && nPts[2]>=1)
     {
-      double stepXYZ[3];
-      for(size_t i=0;i<3;i++)
-	stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
-      
-      for(size_t i=0;i<nPts[0];i++)
-	{
-	  aVec[0]=stepXYZ[0]*(static_cast<double>(i)+0.5);
-	  for(size_t j=0;j<nPts[1];j++)
-	    {
-	      aVec[1]=stepXYZ[1]*(0.5+static_cast<double>(j));
-	      for(size_t k=0;k<nPts[2];k++)
-		{
-		  aVec[2]=stepXYZ[2]*(0.5+static_cast<double>(k));
-		  const Geometry::Vec3D Pt=Origin+aVec;
-		  ObjPtr=System.findCell(Pt,ObjPtr);
-		  
-		  if (!ObjPtr)
-		    ELog::EM<<"Zero Cell == "<<Pt<<ELog::endErr;
-		  MAT[i][j][k]=ObjPtr->getMatID();
-		}
-
-	    }
-	}
+      const size_t NRow(nPts[0]*nPts[1]);
+      std::vector<std::vector<Geometry::Vec3D>> zeroPts(NRow);
+      threadSupport::parallelLoop
+	(System.getThreads(),NRow,
+	 [&](const size_t index)
+	 {
+	   zeroPts[index]=
+	     populateRow(System,index/nPts[1],index % nPts[1]);
+	 });
+
+      for(const std::vector<Geometry::Vec3D>& ZPts : zeroPts)
+	for(const Geometry::Vec3D& Pt : ZPts)
+	  ELog::EM<<"Zero Cell == "<<Pt<<ELog::endErr;
     }
   return;
 }
@@ -423,3 +458,27 @@ FEM::writeFEM(const std::string& FName) const
   OX.close();
   return;
 }
+
+void
+FEM::writeVTI(const std::string& FName) const
+  /*!
+    Write out the VTK XML image data format with the 
+    material [Int32], rhoCp and K [Float32] as raw appended blocks
+    \param FName :: filename 
+  */
+{
+  ELog::RegMethod RegA("FEM","writeVTI");
+  
+  if (FName.empty()) return;
+
+  const Geometry::Vec3D Step(XYZ.X()/static_cast<double>(nPts[0]),
+			     XYZ.Y()/static_cast<double>(nPts[1]),
+			     XYZ.Z()/static_cast<double>(nPts[2]));
+
+  StrFunc::vtiWriter VTI(nPts,Origin+Step/2.0,Step);
+  VTI.addArray("material",matMesh.getVector());
+  VTI.addArray("rhoCp",rhoCp.getVector());
+  VTI.addArray("K",K.getVector());
+  VTI.write(FName);
+  return;
+}
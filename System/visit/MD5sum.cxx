@@ -31,6 +31,8 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -52,6 +54,8 @@
 #include "groupRange.h"
 #include "objectGroups.h"
 #include "Simulation.h"
+#include "SimTrack.h"
+#include "threadSupport.h"
 #include "MatMD5.h"
 #include "MD5sum.h"
 
@@ -144,19 +148,18 @@ MD5sum::setIndex(const size_t A,const size_t B,const size_t C)
 void
 MD5sum::populate(const Simulation* SimPtr)
   /*!
-    The big population call
+    The big population call. The cell search [the expensive part]
+    is split over SimPtr->getThreads() threads, one slab of the
+    outer index per item, with each slab starting from a fresh cell
+    hint. The points are then added to the material sums in 
+    the serial order so the result is independent of the 
+    number of threads.
     \param SimPtr :: Simulation system
    */
 {
   ELog::RegMethod RegA("MD5sum","populate");
   const size_t RSize(Results.size());
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
 
-  size_t percent(0);
-  size_t cnt(0);
-  size_t reportTime(nPts[0]*nPts[1]*nPts[2] / 100);
-  
   std::vector<double> sizeXYZ(3);
   std::vector<size_t> index(3);
   for(size_t i=0;i<3;i++)
@@ -169,41 +172,66 @@ MD5sum::populate(const Simulation* SimPtr)
   const size_t a=index[2];  
   const size_t b=index[1];
   const size_t c=index[0];
-  for(size_t i=0;i<nPts[a];i++)
+
+  auto slabPoint=[&](const size_t i,const size_t j,const size_t k)
     {
+      Geometry::Vec3D aVec;
       aVec[a]=XYZ[a]*(static_cast<double>(i)+0.5)/
 	static_cast<double>(nPts[a]);
-      
-      for(size_t j=0;j<nPts[b];j++)
-        {
-	  aVec[b]=XYZ[b]*(static_cast<double>(j)+0.5)/
-			  static_cast<double>(nPts[b]);
+      aVec[b]=XYZ[b]*(static_cast<double>(j)+0.5)/
+	static_cast<double>(nPts[b]);
+      aVec[c]=XYZ[c]*(static_cast<double>(k)+0.5)/
+	static_cast<double>(nPts[c]);
+      return aVec;
+    };
+
+  // slabs in flight at once [memory of one material index per point]
+  const size_t NSlab(nPts[b]*nPts[c]);
+  const size_t NThreads=
+    threadSupport::threadCount(SimPtr->getThreads(),nPts[a]);
+  const size_t blockSize(std::max<size_t>(NThreads,1));
+  std::vector<size_t> matIndex(blockSize*NSlab);
+  
+  size_t percent(0);
+  for(size_t iStart=0;iStart<nPts[a];iStart+=blockSize)
+    {
+      const size_t NBlock=std::min(blockSize,nPts[a]-iStart);
+      threadSupport::parallelLoop
+	(NThreads,NBlock,
+	 [&](const size_t slab)
+	 {
+	   const size_t i(iStart+slab);
+	   size_t* MPtr=matIndex.data()+slab*NSlab;
+	   ModelSupport::SimTrack::Instance().setCell(SimPtr,0);
+	   MonteCarlo::Object* ObjPtr(0);
+	   for(size_t j=0;j<nPts[b];j++)
+	     for(size_t k=0;k<nPts[c];k++)
+	       {
+		 const Geometry::Vec3D aVec=slabPoint(i,j,k);
+		 ObjPtr=SimPtr->findCell(Origin+aVec,ObjPtr);
+		 const size_t matN=
+		   static_cast<size_t>(ObjPtr->getMatID());
+		 if (matN>=RSize)
+		   throw ColErr::IndexError<size_t>
+		     (matN,RSize,"RSize[point="+
+		      StrFunc::makeString(aVec)+"]");
+		 *MPtr++=matN;
+	       }
+	 });
 
+      // serial order sum
+      const size_t* MPtr=matIndex.data();
+      for(size_t i=iStart;i<iStart+NBlock;i++)
+	for(size_t j=0;j<nPts[b];j++)
 	  for(size_t k=0;k<nPts[c];k++)
-	    {
-	      aVec[c]=XYZ[c]*(static_cast<double>(k)+0.5)/
-		static_cast<double>(nPts[c]);
-	      
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=SimPtr->findCell(Pt,ObjPtr);
-	      const size_t matN=static_cast<size_t>(ObjPtr->getMatID());
-	      if (matN>=RSize)
-		{
-		  throw ColErr::IndexError<size_t>
-		    (matN,RSize,"RSize[point="+StrFunc::makeString(aVec)+"]");
-		}
-	      
-	      Results[matN].addUnit(aVec);
-	      
-	      if (cnt>reportTime)
-		{
-		  percent++;
-		  cnt=0;
-		  ELog::EM<<"On section "<<percent<<" ["
-			  <<reportTime*percent<<"]"<<ELog::endTrace;
-		}
-	      cnt++;
-	    }
+	    Results[*MPtr++].addUnit(slabPoint(i,j,k));
+
+      const size_t newPercent((100*(iStart+NBlock))/nPts[a]);
+      if (newPercent>percent)
+	{
+	  percent=newPercent;
+	  ELog::EM<<"On section "<<percent<<" ["
+		  <<(iStart+NBlock)*NSlab<<"]"<<ELog::endTrace;
 	}
     }
   return;
@@ -33,6 +33,7 @@
 #include <memory>
 #include <array>
 #include <format>
+#include <functional>
 
 #include "FileReport.h"
 #include "NameStack.h"
@@ -54,6 +55,9 @@
 #include "Simulation.h"
 #include "LineUnit.h"
 #include "LineTrack.h"
+#include "threadSupport.h"
+#include "vtiWriter.h"
+#include "visitSupport.h"
 #include "Visit.h"
 
 Visit::Visit() :
@@ -185,7 +189,8 @@ void
 Visit::populateLine(const Simulation& System,
 		    const std::set<std::string>&)
   /*!
-    The big population call with lines
+    The big population call with lines. The lines are
+    split over System.getThreads() threads
     \param System :: Simulation system
     \param Active :: Active set of cells to use (ranged)
    */
@@ -218,9 +223,11 @@ Visit::populateLine(const Simulation& System,
     (IMax==1) ? (YStep*XStep).unit()*XYZ[IMax] :
     (XStep*YStep).unit()*XYZ[IMax];
 
-  for(size_t i=0;i<nA;i++)
-    for(size_t j=0;j<nB;j++)
+  // each line only writes its own mesh units
+  auto lineFunc=[&](const size_t lineIndex)
       { 
+	const size_t i=lineIndex/nB;
+	const size_t j=lineIndex % nB;
 	const Geometry::Vec3D aVec=Origin+
 	  XStep*(static_cast<double>(i)+0.5)+
 	  YStep*(static_cast<double>(j)+0.5);
@@ -242,8 +249,9 @@ Visit::populateLine(const Simulation& System,
 		  getMeshUnit(IMax,index++,i,j)=mValue;
 	      }
 	  }
-      }
-  
+      };
+
+  threadSupport::parallelLoop(System.getThreads(),nA*nB,lineFunc);
   return;
 }
 
@@ -315,60 +323,87 @@ Visit::procPoint(double& unitLen,const double lStep)
   return outCnt;
 }
  
-void
-Visit::populatePoint(const Simulation& System,
-		     const std::set<std::string>& Active)
+std::vector<Geometry::Vec3D>
+Visit::populateRow(const Simulation& System,
+		   const std::set<std::string>& Active,
+		   const size_t i,const size_t j)
   /*!
-    The big population call
+    Populate a single row of constant i,j along z.
+    The cells are found from a track along the row 
+    [visitSupport::rowCells] so the result is independent 
+    of the thread count.
     \param System :: Simulation system
     \param Active :: Active set of cells to use (ranged)
+    \param i :: x index
+    \param j :: y index
+    \return points with no cell
    */
 {
-  ELog::RegMethod RegA("Visit","populatePoint");
-
-  MonteCarlo::Object* ObjPtr(0);
-  Geometry::Vec3D aVec;
+  ELog::RegMethod RegA("Visit","populateRow");
 
   const bool aEmptyFlag=Active.empty();
 
-  double stepXYZ[3];
-  for(size_t i=0;i<3;i++)
-    stepXYZ[i]=XYZ[i]/static_cast<double>(nPts[i]);
+  const Geometry::Vec3D rowPt=Origin+
+    Geometry::Vec3D
+    (XYZ[0]*(static_cast<double>(i)+0.5)/static_cast<double>(nPts[0]),
+     XYZ[1]*(static_cast<double>(j)+0.5)/static_cast<double>(nPts[1]),
+     0.0);
+  const Geometry::Vec3D rowVec(0,0,XYZ[2]);
 
-  for(size_t i=0;i<nPts[0];i++)
+  std::vector<MonteCarlo::Object*> cellVec;
+  std::vector<Geometry::Vec3D> zeroPts;
+  if (visitSupport::rowCells(System,rowPt,rowVec,nPts[2],cellVec))
     {
-      aVec[0]=stepXYZ[0]*(static_cast<double>(i)+0.5);
-      for(size_t j=0;j<nPts[1];j++)
-        {
-	  aVec[1]=stepXYZ[1]*(0.5+static_cast<double>(j));
-	  for(size_t k=0;k<nPts[2];k++)
-	    {
-	      aVec[2]=stepXYZ[2]*(0.5+static_cast<double>(k));
-	      const Geometry::Vec3D Pt=Origin+aVec;
-	      ObjPtr=System.findCell(Pt,ObjPtr);
-	      
-	      // Active Set Code:
-	      if (!aEmptyFlag)
-		{
-		  const std::string rangeStr=
-		    System.inRange(ObjPtr->getName());
-		  
-		  if (Active.find(rangeStr)!=Active.end())
-		    mesh.get()[i][j][k]=getResult(ObjPtr);
-		  else
-		    mesh.get()[i][j][k]=0.0;
-		}
-	      // OLD Code:
-	      else
-		{
-		  if (!ObjPtr)
-		    ELog::EM<<"Zero Cell == "<<Pt<<ELog::endErr;
-		  mesh.get()[i][j][k]=getResult(ObjPtr);
-		}
-
-	    }
+      for(size_t k=0;k<nPts[2];k++)
+	if (!cellVec[k])
+	  zeroPts.push_back
+	    (rowPt+rowVec*((static_cast<double>(k)+0.5)/
+			   static_cast<double>(nPts[2])));
+    }
+  
+  for(size_t k=0;k<nPts[2];k++)
+    {
+      const MonteCarlo::Object* ObjPtr=cellVec[k];
+      // Active Set Code:
+      if (!aEmptyFlag)
+	{
+	  const std::string rangeStr=(ObjPtr) ?
+	    System.inRange(ObjPtr->getName()) : "";
+	  mesh.get()[i][j][k]=(Active.find(rangeStr)!=Active.end()) ?
+	    getResult(ObjPtr) : 0.0;
 	}
+      else
+	mesh.get()[i][j][k]=getResult(ObjPtr);
     }
+  return zeroPts;
+}
+
+void
+Visit::populatePoint(const Simulation& System,
+		     const std::set<std::string>& Active)
+  /*!
+    The big population call. Rows along z are split
+    over System.getThreads() threads. Points with no 
+    cell are reported in mesh order.
+    \param System :: Simulation system
+    \param Active :: Active set of cells to use (ranged)
+   */
+{
+  ELog::RegMethod RegA("Visit","populatePoint");
+
+  const size_t NRow(nPts[0]*nPts[1]);
+  std::vector<std::vector<Geometry::Vec3D>> zeroPts(NRow);
+  threadSupport::parallelLoop
+    (System.getThreads(),NRow,
+     [&](const size_t index)
+     {
+       zeroPts[index]=populateRow(System,Active,
+				  index/nPts[1],index % nPts[1]);
+     });
+
+  for(const std::vector<Geometry::Vec3D>& ZPts : zeroPts)
+    for(const Geometry::Vec3D& Pt : ZPts)
+      ELog::EM<<"Zero Cell == "<<Pt<<ELog::endErr;
   return;
 }
 
@@ -499,3 +534,49 @@ Visit::writeIntegerVTK(const std::string& FName) const
   OX.close();
   return;
 }
+
+std::string
+Visit::getTypeName() const
+  /*!
+    Name of the output type [for data arrays]
+    \return name of outType
+  */
+{
+  switch(outType)
+    {
+    case VISITenum::cellID:
+      return "cellID";
+    case VISITenum::material:
+      return "material";
+    case VISITenum::density:
+      return "density";
+    case VISITenum::imp:
+      return "imp";
+    case VISITenum::weight:
+      return "weight";
+    }
+  return "cellID";
+}
+
+void
+Visit::writeVTI(const std::string& FName,const bool intFlag) const
+  /*!
+    Write out the VTK XML image data format with the
+    mesh as a single raw appended block [Int32/Float32]
+    \param FName :: filename 
+    \param intFlag :: write as integer
+  */
+{
+  ELog::RegMethod RegA("Visit","writeVTI");
+  
+  if (FName.empty()) return;
+
+  const Geometry::Vec3D Step(XYZ.X()/static_cast<double>(nPts[0]),
+			     XYZ.Y()/static_cast<double>(nPts[1]),
+			     XYZ.Z()/static_cast<double>(nPts[2]));
+
+  StrFunc::vtiWriter VTI(nPts,Origin+Step/2.0,Step);
+  VTI.addArray(getTypeName(),mesh.getVector(),intFlag);
+  VTI.write(FName);
+  return;
+}
@@ -0,0 +1,126 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   visit/visitSupport.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <map> 
+#include <list> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <memory>
+ 
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Vec3D.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "HeadRule.h"
+#include "Importance.h"
+#include "Object.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "LineUnit.h"
+#include "LineTrack.h"
+#include "SimTrack.h"
+#include "visitSupport.h"
+
+///\file System/visit/visitSupport.cxx
+
+namespace visitSupport
+{
+
+size_t
+rowCells(const Simulation& System,
+	 const Geometry::Vec3D& rowPt,
+	 const Geometry::Vec3D& rowVec,
+	 const size_t N,
+	 std::vector<MonteCarlo::Object*>& cellVec)
+  /*!
+    Find the cell of N points at the centres of equal steps 
+    along a row from a single track. Points are given the cell 
+    of the track segment they are in, so the cost scales with 
+    the number of boundaries crossed. findCell is only used for 
+    points within tolerance of a boundary or not covered by the track.
+    The result only depends on the row [not the thread].
+    \param System :: Simulation system
+    \param rowPt :: Start of the row
+    \param rowVec :: Full length of the row
+    \param N :: Number of points
+    \param cellVec :: cell of each point [0 if none] [OUTPUT]
+    \return number of points with no cell
+   */
+{
+  ELog::RegMethod RegA("visitSupport[F]","rowCells");
+
+  cellVec.resize(N);
+  const double lStep=rowVec.abs()/static_cast<double>(N);
+  const Geometry::Vec3D stepVec=rowVec/static_cast<double>(N);
+
+  ModelSupport::SimTrack::Instance().setCell(&System,0);
+
+  std::vector<ModelSupport::LineUnit> trackPts;
+  if (N>1 && lStep>Geometry::zeroTol &&
+      System.findCell(rowPt,0))
+    {
+      ModelSupport::LineTrack OTrack(rowPt,rowPt+rowVec);
+      OTrack.calculate(System);
+      trackPts=OTrack.getTrackPts();
+    }
+
+  size_t nZero(0);
+  size_t segIndex(0);
+  double segStart(0.0);
+  double segEnd(trackPts.empty() ? 0.0 : trackPts[0].segmentLength);
+  MonteCarlo::Object* ObjPtr(0);
+  for(size_t k=0;k<N;k++)
+    {
+      const double D=lStep*(static_cast<double>(k)+0.5);
+      while(segIndex<trackPts.size() && segEnd<D)
+	{
+	  segIndex++;
+	  segStart=segEnd;
+	  if (segIndex<trackPts.size())
+	    segEnd+=trackPts[segIndex].segmentLength;
+	}
+      if (segIndex<trackPts.size() && trackPts[segIndex].objPtr &&
+	  D-segStart>Geometry::zeroTol && segEnd-D>Geometry::zeroTol)
+	ObjPtr=trackPts[segIndex].objPtr;
+      else
+	ObjPtr=System.findCell(rowPt+stepVec*(static_cast<double>(k)+0.5),
+			       ObjPtr);
+      cellVec[k]=ObjPtr;
+      if (!ObjPtr) nZero++;
+    }
+  return nZero;
+}
+
+} // NAMESPACE visitSupport
@@ -65,6 +65,8 @@ class FEM
 
   static size_t procPoint(double&,const double);
   void populateLine(const Simulation&);
+  std::vector<Geometry::Vec3D>
+  populateRow(const Simulation&,const size_t,const size_t);
   void populatePoint(const Simulation&);
   
  public:
@@ -83,6 +85,7 @@ class FEM
   void populate(const Simulation&);
   
   void writeFEM(const std::string&) const;
+  void writeVTI(const std::string&) const;
 
 };
 
@@ -34,7 +34,6 @@ class Object;
   \date August 2010
   \author S. Ansell
   \version 1.0
-  \todo Move to a binary/xml output schema
 
   This allows comparison of the vector for removing non-unique
   Vec3D from a list
@@ -63,10 +62,14 @@ class Visit
   static long int procPoint(double&,const double);
 
   double getResult(const MonteCarlo::Object*) const;
+  std::string getTypeName() const;
   size_t getMaxIndex() const;
 
   double& getMeshUnit(const size_t,const size_t,
 		      const size_t,const size_t);
+  std::vector<Geometry::Vec3D>
+  populateRow(const Simulation&,const std::set<std::string>&,
+	      const size_t,const size_t);
   
  public:
 
@@ -87,6 +90,7 @@ class Visit
   void populate(const Simulation&,const std::set<std::string>&);
   void writeVTK(const std::string&) const;
   void writeIntegerVTK(const std::string&) const;
+  void writeVTI(const std::string&,const bool) const;
 };
 
 
@@ -0,0 +1,44 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   visitInc/visitSupport.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef visitSupport_h
+#define visitSupport_h
+
+///\file System/visitInc/visitSupport.h
+
+class Simulation;
+
+namespace MonteCarlo
+{
+  class Object;
+}
+
+namespace visitSupport
+{
+
+size_t
+rowCells(const Simulation&,const Geometry::Vec3D&,
+	 const Geometry::Vec3D&,const size_t,
+	 std::vector<MonteCarlo::Object*>&);
+
+}
+
+#endif
@@ -3,7 +3,7 @@
  
  * File:   weight/MarkovProcess.cxx
  *
- * Copyright (c) 2004-2024 by Stuart Ansell
+ * Copyright (c) 2004-2026 by Stuart Ansell
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -31,6 +31,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -38,6 +39,12 @@
 #include "RegMethod.h"
 #include "OutputLog.h"
 #include "Vec3D.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
 #include "dataSlice.h"
 #include "multiData.h"
 #include "BasicMesh3D.h"
@@ -47,6 +54,7 @@
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
+#include "threadSupport.h"
 #include "WWGWeight.h"
 #include "WWG.h"
 
@@ -57,15 +65,18 @@ namespace WeightSystem
 {
 
 
-MarkovProcess::MarkovProcess()
+MarkovProcess::MarkovProcess() :
+  nIteration(0),WE(0),WX(0),WY(0),WZ(0),FSize(0),
+  maxRadius(0.0)
  /*! 
     Constructor 
   */
 {}
 
 MarkovProcess::MarkovProcess(const MarkovProcess& A) : 
-  nIteration(A.nIteration),WX(A.WX),WY(A.WY),WZ(A.WZ),
-  FSize(A.FSize),fluxField(A.fluxField)
+  nIteration(A.nIteration),WE(A.WE),WX(A.WX),WY(A.WY),WZ(A.WZ),
+  FSize(A.FSize),maxRadius(A.maxRadius),rowStart(A.rowStart),
+  colIndex(A.colIndex),fluxField(A.fluxField),fluxVec(A.fluxVec)
   /*!
     Copy constructor
     \param A :: MarkovProcess to copy
@@ -83,11 +94,16 @@ MarkovProcess::operator=(const MarkovProcess& A)
   if (this!=&A)
     {
       nIteration=A.nIteration;
+      WE=A.WE;
       WX=A.WX;
       WY=A.WY;
       WZ=A.WZ;
       FSize=A.FSize;
+      maxRadius=A.maxRadius;
+      rowStart=A.rowStart;
+      colIndex=A.colIndex;
       fluxField=A.fluxField;
+      fluxVec=A.fluxVec;
     }
   return *this;
 }
@@ -102,7 +118,8 @@ void
 MarkovProcess::initializeData(const WWG& wSet,
 			      const std::string& meshIndex)
   /*!
-    Initialize all the values before execusion
+    Initialize all the values before execusion.
+    The flux vector is taken from the current mesh weights
     \param wSet :: wwg
     \param meshIndex to process
   */
@@ -112,13 +129,24 @@ MarkovProcess::initializeData(const WWG& wSet,
   const WWGWeight& wMesh=wSet.getMesh(meshIndex);
   const Geometry::BasicMesh3D& grid=wMesh.getGeomGrid();
   
+  WE=wMesh.getESize();
   WX=grid.getXSize();
   WY=grid.getYSize();
   WZ=grid.getZSize();
 
   FSize=WX*WY*WZ;
+
+  rowStart.clear();
+  colIndex.clear();
+  fluxField.clear();
   
-  fluxField.resize(FSize,FSize);
+  // WGrid is in log space : values >0.5 are unset [weight 1.0]
+  const multiData<double>& WGrid=wMesh.getGrid();
+  const double* WPtr=WGrid.getPtr();
+  fluxVec.resize(WE,FSize);
+  double* FPtr=fluxVec.getPtr();
+  for(size_t i=0;i<WE*FSize;i++)
+    FPtr[i]=(WPtr[i]>0.5) ? 1.0 : std::exp(WPtr[i]);
   
   return;
 }
@@ -131,7 +159,8 @@ MarkovProcess::computeMatrix(const Simulation& System,
 			     const double r2Length,
 			     const double r2Power)
   /*!
-    Calculate the Markov chain process
+    Calculate the Markov chain process from the attenuation
+    between mesh points. See buildMatrix for the pair selection.
     \param System :: Simualation
     \param wSet :: WWG set for grid
     \param meshIdnex :: mesh to use  	
@@ -150,43 +179,233 @@ MarkovProcess::computeMatrix(const Simulation& System,
     throw ColErr::MisMatch<size_t>
       (midPts.size(),FSize,"MidPts.size != FSize");
 
-  for(size_t i=0;i<FSize;i++)
-    fluxField.get()[i][i]=1.0;
-
-  for(size_t i=0;i<FSize;i++)
+  auto logFactor=[&](const size_t i,const size_t j) -> double
     {
       ModelSupport::ObjectTrackPoint OTrack(midPts[i]); 
-      for(size_t j=i+1;j<FSize;j++)
+      OTrack.addUnit(System,0,midPts[j]);
+      double DistT=OTrack.getDistance(0)/r2Length;
+      if (DistT<1.0) DistT=1.0;
+      const double AT=OTrack.getAttnSum(0);
+      return -densityFactor*AT-r2Power*std::log(DistT);
+    };
+  
+  buildMatrix(System.getThreads(),grid,logFactor);
+  return;
+}
+
+void
+MarkovProcess::buildMatrix(const size_t nThreads,
+			   const Geometry::BasicMesh3D& grid,
+			   const std::function<double(const size_t,
+						      const size_t)>&
+			   logFactor)
+  /*!
+    Build the upper triangle of the symmetric transfer matrix
+    [diagonal is unity and not stored]. From each point the
+    mesh is walked in cubic shells of increasing index distance
+    and the walk stops at the first shell where no pair is above
+    the cut-off [or at maxRadius : default defShell mesh steps].
+    \param nThreads :: Number of threads
+    \param grid :: Mesh [size WX,WY,WZ]
+    \param logFactor :: log transfer factor between points i,j
+   */
+{
+  ELog::RegMethod RegA("MarkovProcess","buildMatrix");
+
+  const std::vector<Geometry::Vec3D> midPts=grid.midPoints();
+  if (midPts.size()!=FSize)
+    throw ColErr::MisMatch<size_t>
+      (midPts.size(),FSize,"MidPts.size != FSize");
+  
+  // mesh steps / search radius
+  const Geometry::Vec3D Span=grid.getHigh()-grid.getLow();
+  const double step[3]=
+    {
+      std::abs(Span.X())/static_cast<double>(WX),
+      std::abs(Span.Y())/static_cast<double>(WY),
+      std::abs(Span.Z())/static_cast<double>(WZ)
+    };
+  const double radius((maxRadius>Geometry::zeroTol) ? maxRadius :
+		      static_cast<double>(defShell)*
+		      std::max(step[0],std::max(step[1],step[2])));
+  const size_t WN[3]={WX,WY,WZ};
+  size_t RN[3];
+  for(size_t i=0;i<3;i++)
+    {
+      const double R=(step[i]>Geometry::zeroTol) ?
+	std::ceil(radius/step[i]-Geometry::zeroTol) : 0.0;
+      RN[i]=(R<static_cast<double>(WN[i])) ? static_cast<size_t>(R) : WN[i];
+    }
+  const size_t maxShell=std::max(RN[0],std::max(RN[1],RN[2]));
+
+  // Upper triangle [j>i] elements of each row
+  std::vector<std::vector<std::pair<size_t,double>>> upper(FSize);
+  auto calcRow=[&](const size_t i)
+    {
+      const long int IN[3]=
 	{
-	  OTrack.addUnit(System,j,midPts[j]);
-	  double DistT=OTrack.getDistance(static_cast<long int>(j))/r2Length;
-	  if (DistT<1.0) DistT=1.0;
-	  const double AT=OTrack.getAttnSum(static_cast<long int>(j));  // this can take an
-	  const double WFactor= -densityFactor*AT-r2Power*log(DistT);
-	  if (WFactor>-20)
-	    {
-	      fluxField.get()[i][j]= -WFactor;
-	      fluxField.get()[j][i]= -WFactor;
-	    }
-	  else
+	  static_cast<long int>(i/(WY*WZ)),
+	  static_cast<long int>((i/WZ) % WY),
+	  static_cast<long int>(i % WZ)
+	};
+      // is the index offset in range : 
+      auto inRange=[&](const size_t axis,const long int D) -> bool
+	{
+	  const long int V=IN[axis]+D;
+	  return (std::abs(D)<=static_cast<long int>(RN[axis]) &&
+		  V>=0 && V<static_cast<long int>(WN[axis]));
+	};
+
+      std::vector<std::pair<size_t,double>>& Row(upper[i]);
+      for(size_t shell=1;shell<=maxShell;shell++)
+	{
+	  const long int K(static_cast<long int>(shell));
+	  bool found(0);
+	  for(long int dx=-K;dx<=K;dx++)
 	    {
-	      fluxField.get()[i][j]= 0.0;
-	      fluxField.get()[j][i]= 0.0;
+	      if (!inRange(0,dx)) continue;
+	      for(long int dy=-K;dy<=K;dy++)
+		{
+		  if (!inRange(1,dy)) continue;
+		  // only the two faces of the shell in z unless on edge
+		  const long int dzStep=
+		    (std::abs(dx)==K || std::abs(dy)==K) ? 1 : 2*K;
+		  for(long int dz=-K;dz<=K;dz+=dzStep)
+		    {
+		      if (!inRange(2,dz)) continue;
+		      const size_t j=static_cast<size_t>
+			(((IN[0]+dx)*static_cast<long int>(WY)+IN[1]+dy)*
+			 static_cast<long int>(WZ)+IN[2]+dz);
+		      if (j<=i ||
+			  midPts[i].Distance(midPts[j])>radius)
+			continue;
+		      const double WFactor=logFactor(i,j);
+		      if (WFactor>cutValue)
+			{
+			  Row.push_back(std::pair<size_t,double>
+					(j,std::exp(WFactor)));
+			  found=1;
+			}
+		    }
+		}
 	    }
+	  if (!found) break;
+	}
+      std::sort(Row.begin(),Row.end());
+    };
+  threadSupport::parallelLoop(nThreads,FSize,calcRow);
+
+  // CSR build of the upper triangle : rows released as copied
+  rowStart.resize(FSize+1);
+  rowStart[0]=0;
+  for(size_t i=0;i<FSize;i++)
+    rowStart[i+1]=rowStart[i]+upper[i].size();
+
+  colIndex.resize(rowStart[FSize]);
+  fluxField.resize(rowStart[FSize]);
+  for(size_t i=0;i<FSize;i++)
+    {
+      size_t index(rowStart[i]);
+      for(const std::pair<size_t,double>& jv : upper[i])
+	{
+	  colIndex[index]=jv.first;
+	  fluxField[index++]=jv.second;
 	}
+      std::vector<std::pair<size_t,double>>().swap(upper[i]);
     }
+  ELog::EM<<"Markov matrix : "<<FSize<<" points "
+	  <<fluxField.size()<<" pairs [radius "<<radius<<"]"
+	  <<ELog::endDiag;
   return;
 }
 
 void
-MarkovProcess::multiplyOut(const size_t index)
+MarkovProcess::multiplyVec(const std::vector<double>& inVec,
+			   std::vector<double>& outVec) const
+  /*!
+    Sparse matrix vector product : outVec = fluxField * inVec
+    using the stored upper triangle for both halves
+    and a unit diagonal.
+    \param inVec :: Input vector [FSize]
+    \param outVec :: Output vector [FSize]
+  */
 {
+  outVec.assign(inVec.begin(),inVec.end());
+  for(size_t i=0;i<FSize;i++)
+    {
+      double sum(0.0);
+      for(size_t index=rowStart[i];index<rowStart[i+1];index++)
+	{
+	  const size_t j=colIndex[index];
+	  sum+=fluxField[index]*inVec[j];
+	  outVec[j]+=fluxField[index]*inVec[i];
+	}
+      outVec[i]+=sum;
+    }
   return;
 }
 
 void
-MarkovProcess::rePopulateWWG() 
+MarkovProcess::multiplyOut(const size_t nIter)
+  /*!
+    Power iteration of the flux vector of each energy 
+    bin through the transfer matrix. The vector is 
+    normalized to a maximum of unity after each step.
+    \param nIter :: Number of iterations
+  */
 {
+  ELog::RegMethod RegA("MarkovProcess","multiplyOut");
+
+  if (rowStart.size()!=FSize+1)
+    throw ColErr::EmptyContainer("Markov matrix not computed");
+
+  nIteration=nIter;
+  std::vector<double> inVec(FSize);
+  std::vector<double> outVec(FSize);
+  for(size_t e=0;e<WE;e++)
+    {
+      double* FPtr=fluxVec.getPtr()+e*FSize;
+      inVec.assign(FPtr,FPtr+FSize);
+      for(size_t iter=0;iter<nIteration;iter++)
+	{
+	  multiplyVec(inVec,outVec);
+	  const double maxV=
+	    *std::max_element(outVec.begin(),outVec.end());
+	  if (maxV>0.0)
+	    for(double& V : outVec)
+	      V/=maxV;
+	  std::swap(inVec,outVec);
+	}
+      std::copy(inVec.begin(),inVec.end(),FPtr);
+    }
+  return;
+}
+
+void
+MarkovProcess::rePopulateWWG(WWG& wSet,
+			     const std::string& meshIndex) const
+  /*!
+    Write the flux vector back into the mesh [log space]
+    \param wSet :: wwg
+    \param meshIndex :: mesh to update
+  */
+{
+  ELog::RegMethod RegA("MarkovProcess","rePopulateWWG");
+
+  const double minLOG(-100.0);
+  
+  WWGWeight& wMesh=wSet.getMesh(meshIndex);
+  if (!wMesh.isSized(WX,WY,WZ,WE))
+    throw ColErr::MisMatch<size_t>
+      (FSize,wMesh.getGeomGrid().size(),"Mesh changed size");
+
+  const double* FPtr=fluxVec.getPtr();
+  for(size_t e=0;e<WE;e++)
+    for(size_t i=0;i<FSize;i++)
+      {
+	const double V=FPtr[e*FSize+i];
+	wMesh.setLogPoint(i,e,(V>std::exp(minLOG)) ? std::log(V) : minLOG);
+      }
   return;
 }
   
@@ -0,0 +1,226 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   weights/TrackCache.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <array>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Vec3D.h"
+#include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
+#include "BasicMesh3D.h"
+#include "HeadRule.h"
+#include "Importance.h"
+#include "Object.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "AttnTable.h"
+#include "LineUnit.h"
+#include "LineTrack.h"
+#include "TrackCache.h"
+
+namespace WeightSystem
+{
+
+void
+trackPath::fill(const ModelSupport::LineTrack& LT)
+  /*!
+    Set the path from a track
+    \param LT :: Line track [calculated]
+  */
+{
+  distance=LT.getTotalDist();
+  segments.clear();
+  for(const ModelSupport::LineUnit& lu : LT.getTrackPts())
+    {
+      const MonteCarlo::Object* OPtr=lu.objPtr;
+      if (OPtr)
+	{
+	  const MonteCarlo::Material* MPtr=OPtr->getMatPtr();
+	  if (!MPtr->isVoid())
+	    segments.push_back({MPtr,lu.segmentLength});
+	}
+    }
+  set=1;
+  return;
+}
+
+std::vector<double>
+trackPath::attnSum(const std::vector<double>& EVec) const
+  /*!
+    Calculate the attenuation sum along the path 
+    [same as ObjectTrackAct::getAttnSum]
+    \param EVec :: Energies [MeV]
+    \return sum of attenuation for each energy
+  */
+{
+  const ModelSupport::AttnTable& AT=
+    ModelSupport::AttnTable::Instance();
+
+  std::vector<size_t> EGroup;
+  for(const double E : EVec)
+    EGroup.push_back(AT.getGroup(E));
+
+  std::vector<double> sum(EVec.size(),0.0);
+  for(const auto& [MPtr,length] : segments)
+    for(size_t i=0;i<EVec.size();i++)
+      sum[i]+=AT.trackAttn(*MPtr,length,EVec[i],EGroup[i]);
+  return sum;
+}
+  
+TrackCache::TrackCache() :
+  maxSegment(20000000),nSegment(0)
+  /*!
+    Constructor
+  */
+{}
+
+TrackCache&
+TrackCache::Instance()
+  /*!
+    Singleton this
+    \return TrackCache object
+   */
+{
+  static TrackCache TC;
+  return TC;
+}
+
+std::string
+TrackCache::meshKey(const Geometry::BasicMesh3D& Grid)
+  /*!
+    Key component for the mesh
+    \param Grid :: Mesh
+    \return key string
+  */
+{
+  std::ostringstream cx;
+  const Geometry::Vec3D& LPt=Grid.getLow();
+  const Geometry::Vec3D& HPt=Grid.getHigh();
+  cx<<std::setprecision(17)
+    <<LPt.X()<<" "<<LPt.Y()<<" "<<LPt.Z()<<" "
+    <<HPt.X()<<" "<<HPt.Y()<<" "<<HPt.Z()<<" "
+    <<Grid.getXSize()<<" "<<Grid.getYSize()<<" "<<Grid.getZSize();
+  return cx.str();
+}
+
+std::string
+TrackCache::makeKey(const Geometry::Vec3D& Pt,
+		    const Geometry::BasicMesh3D& Grid)
+  /*!
+    Key for a source point on a mesh
+    \param Pt :: Source point
+    \param Grid :: Mesh
+    \return key string
+  */
+{
+  std::ostringstream cx;
+  cx<<std::setprecision(17)
+    <<"P "<<Pt.X()<<" "<<Pt.Y()<<" "<<Pt.Z()<<" : "<<meshKey(Grid);
+  return cx.str();
+}
+
+std::string
+TrackCache::makeKey(const Geometry::Plane& PL,
+		    const Geometry::BasicMesh3D& Grid)
+  /*!
+    Key for a source plane on a mesh
+    \param PL :: Source plane
+    \param Grid :: Mesh
+    \return key string
+  */
+{
+  const Geometry::Vec3D& N=PL.getNormal();
+  std::ostringstream cx;
+  cx<<std::setprecision(17)
+    <<"S "<<N.X()<<" "<<N.Y()<<" "<<N.Z()<<" "<<PL.getDistance()
+    <<" : "<<meshKey(Grid);
+  return cx.str();
+}
+
+void
+TrackCache::clear()
+  /*!
+    Remove all the paths
+  */
+{
+  cacheMap.clear();
+  nSegment=0;
+  return;
+}
+
+TrackCache::PTYPE&
+TrackCache::getSet(const std::string& key,const size_t N)
+  /*!
+    Get the path set for a source/mesh [created if needed].
+    Not thread safe : call before the grid loop.
+    \param key :: key from makeKey
+    \param N :: number of grid points
+    \return path set
+  */
+{
+  ELog::RegMethod RegA("TrackCache","getSet");
+
+  std::map<std::string,PTYPE>::iterator mc=cacheMap.find(key);
+  if (mc==cacheMap.end())
+    mc=cacheMap.emplace(key,PTYPE(N)).first;
+  else if (mc->second.size()!=N)
+    throw ColErr::MisMatch<size_t>(mc->second.size(),N,"Path set size");
+  return mc->second;
+}
+
+void
+TrackCache::store(trackPath& slot,trackPath& path)
+  /*!
+    Move a path into its slot if the memory bound allows.
+    Different slots can be stored from different threads.
+    \param slot :: Cache slot [unset]
+    \param path :: Calculated path [moved if stored]
+  */
+{
+  const size_t NS=path.segments.size()+1;
+  if (nSegment.fetch_add(NS)+NS<=maxSegment)
+    slot=std::move(path);
+  else
+    nSegment-=NS;
+  return;
+}
+  
+} // NAMESPACE WeightSystem
@@ -32,6 +32,7 @@
 #include <string>
 #include <algorithm>
 #include <memory>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -59,16 +60,18 @@
 #include "objectGroups.h"
 #include "Simulation.h"
 #include "SimMCNP.h"
-#include "vertexCalc.h"
 #include "inputParam.h"
 #include "ImportControl.h"
 #include "support.h"
 
+#include "AttnTable.h"
 #include "LineUnit.h"
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
 #include "ObjectTrackPoint.h"
 #include "ObjectTrackPlane.h"
+#include "SimTrack.h"
+#include "threadSupport.h"
 #include "TempWeights.h"
 #include "WeightControl.h"
 #include "WCellControl.h"
@@ -424,7 +427,8 @@ WCellControl::cTrack(const Simulation& System,
                       const std::vector<long int>& index,
                       CellWeight& CTrack)
   /*!
-    Calculate a specific track from sourcePoint to  postion
+    Calculate a specific track from sourcePoint to  postion.
+    The tracks are split over System.getThreads() threads
     \param System :: Simulation to use    
     \param initPt :: point for outgoing track
     \param Pts :: Point on track
@@ -435,16 +439,25 @@ WCellControl::cTrack(const Simulation& System,
   ELog::RegMethod RegA("WCellControl","cTrack");
   // SOURCE Point
 
-  ModelSupport::ObjectTrackPoint OTrack(initPt);
-  std::vector<double> WVec;
-
+  std::vector<long int> unitVec(Pts.size());
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
-    {
-      const long int unit(i>=index.size() ? cN++ : index[i]);
-      OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
-    } 
+    unitVec[i]=(i>=index.size()) ? cN++ : index[i];
+
+  // each track is independent : only CTrack is shared
+  std::vector<double> AVec(Pts.size());
+  threadSupport::parallelLoop
+    (System.getThreads(),Pts.size(),
+     [&](const size_t i)
+     {
+       ModelSupport::SimTrack::Instance().setCell(&System,0);
+       ModelSupport::ObjectTrackPoint OTrack(initPt);
+       OTrack.addUnit(System,unitVec[i],Pts[i]);
+       AVec[i]=OTrack.getAttnSum(unitVec[i]);
+     });
+  
+  for(size_t i=0;i<Pts.size();i++)
+    CTrack.addTracks(unitVec[i],AVec[i]);
   return;
 }
 
@@ -455,7 +468,8 @@ WCellControl::cTrack(const Simulation& System,
                       const std::vector<long int>& index,
                       CellWeight& CTrack)
   /*!
-    Calculate a specific track from sourcePoint to postion
+    Calculate a specific track from sourcePoint to postion.
+    The tracks are split over System.getThreads() threads
     \param System :: Simulation to use    
     \param initPlane :: Plane for outgoing track
     \param Pts :: Point on track
@@ -466,16 +480,25 @@ WCellControl::cTrack(const Simulation& System,
   ELog::RegMethod RegA("WCellControl","cTrack");
   // SOURCE Point
 
-  ModelSupport::ObjectTrackPlane OTrack(initPlane);
-  std::vector<double> WVec;
-
+  std::vector<long int> unitVec(Pts.size());
   long int cN(index.empty() ? 1 : index.back());
   for(size_t i=0;i<Pts.size();i++)
-    {
-      const long int unit(i>=index.size() ? cN++ : index[i]);
-      OTrack.addUnit(System,unit,Pts[i]);
-      CTrack.addTracks(unit,OTrack.getAttnSum(unit));
-    } 
+    unitVec[i]=(i>=index.size()) ? cN++ : index[i];
+
+  // each track is independent : only CTrack is shared
+  std::vector<double> AVec(Pts.size());
+  threadSupport::parallelLoop
+    (System.getThreads(),Pts.size(),
+     [&](const size_t i)
+     {
+       ModelSupport::SimTrack::Instance().setCell(&System,0);
+       ModelSupport::ObjectTrackPlane OTrack(initPlane);
+       OTrack.addUnit(System,unitVec[i],Pts[i]);
+       AVec[i]=OTrack.getAttnSum(unitVec[i]);
+     });
+  
+  for(size_t i=0;i<Pts.size();i++)
+    CTrack.addTracks(unitVec[i],AVec[i]);
   return;
 }
 
@@ -505,7 +528,7 @@ WCellControl::calcCellTrack(const Simulation& System,
       if (CellPtr && !CellPtr->isVoid())
 	{
 	  index.push_back(CellPtr->getName());  // this should be cellN ??
-	  Pts.push_back(ModelSupport::calcCOFM(*CellPtr));
+	  Pts.push_back(CellPtr->getCofM());
 	}
     }
   //  cTrack(System,curCone,Pts,index,CTrack);
@@ -537,7 +560,7 @@ WCellControl::calcCellTrack(const Simulation& System,
       if (CellPtr && !CellPtr->isVoid())
         {
           index.push_back(CellPtr->getName());  // this should be cellN ??
-	  Pts.push_back(ModelSupport::calcCOFM(*CellPtr));
+	  Pts.push_back(CellPtr->getCofM());
         }
     }
 
@@ -569,9 +592,7 @@ WCellControl::calcCellTrack(const Simulation& System,
       if (CellPtr && !CellPtr->isVoid())
         {
           index.push_back(CellPtr->getName());  // this should be cellN ??
-	  //          Pts.push_back(CellPtr->getCofM());
-          ELog::EM<<"Cell Track = "<<initPt<<" : "<<index.back()
-                  <<" : [COM] "<<Pts.back()<<ELog::endDiag;
+	  Pts.push_back(CellPtr->getCofM());
         }
     }
 
@@ -665,7 +686,12 @@ WCellControl::processWeights(Simulation& System,
   
     
   if (IParam.flag("weightObject"))
-    procObject(System,IParam);
+    {
+      ModelSupport::AttnTable& AT=ModelSupport::AttnTable::Instance();
+      AT.setEnergyScale(IParam.flag("wAttnE"));
+      AT.build();
+      procObject(System,IParam);
+    }
 
 
   return;
@@ -53,7 +53,7 @@ namespace WeightSystem
 
 WWG::WWG() :
   wupn(8.0),wsurv(1.4),maxsp(5),
-  mwhere(-1),mtime(0),switchn(-2)
+  mwhere(-1),mtime(0),switchn(-2),binaryFlag(0)
   /*!
     Constructor : 
     set mwhere[-1] - collisions only 
@@ -63,7 +63,7 @@ WWG::WWG() :
 WWG::WWG(const WWG& A) : 
   wupn(A.wupn),wsurv(A.wsurv),maxsp(A.maxsp),
   mwhere(A.mwhere),mtime(A.mtime),switchn(A.switchn),
-  refPt(A.refPt),defUnit(A.defUnit)
+  refPt(A.refPt),binaryFlag(A.binaryFlag),defUnit(A.defUnit)
   /*!
     Copy constructor
     \param A :: WWG to copy
@@ -90,6 +90,7 @@ WWG::operator=(const WWG& A)
       mtime=A.mtime;
       switchn=A.switchn;
       refPt=A.refPt;
+      binaryFlag=A.binaryFlag;
       for(auto& [ Name,WPtr ] : WMeshMap)
 	delete WPtr;
       WMeshMap.clear();
@@ -352,6 +353,11 @@ WWG::writeWWINP(const std::string& FName) const
 {
   ELog::RegMethod RegA("WWG","writeWWINP");
 
+  if (binaryFlag)
+    {
+      writeWWINPBinary(FName+".bin");
+      return;
+    }
   
   const WWGWeight& WMesh=getMesh(defUnit);
   if (!FName.empty())
@@ -363,14 +369,34 @@ WWG::writeWWINP(const std::string& FName) const
   return;
 }  
 
+void
+WWG::writeWWINPBinary(const std::string& FName) const
+  /*!
+    Write out the default mesh as a binary wwinp 
+    equivalent [see WWGWeight::writeWWINPBinary]
+    \param FName :: Output filename
+  */
+{
+  ELog::RegMethod RegA("WWG","writeWWINPBinary");
+
+  const WWGWeight& WMesh=getMesh(defUnit);
+  if (!FName.empty())
+    {
+      std::ofstream OX(FName.c_str(),std::ios::out | std::ios::binary);
+      WMesh.writeWWINPBinary(OX);
+    }
+  return;
+}  
+
 void
 WWG::writeVTK(const std::string& FName,
 	      const bool logFlag,
 	      const std::string& meshName,
 	      const size_t EIndex) const
   /*!
-    Write out a VTK file
+    Write out a VTK file [binary .vti if FName ends in .vti]
     \param FName :: filename 
+    \param logFlag :: Write as log value
     \param meshName :: Mesh name
     \param EIndex :: energy index
   */
@@ -379,9 +405,17 @@ WWG::writeVTK(const std::string& FName,
 
   ELog::EM<<"WRITE VTK"<<" "<<FName<<" : "<<meshName<<" "<<EIndex<<ELog::endDiag;
   if (FName.empty()) return;
-  std::ofstream OX(FName.c_str());
 
   const WWGWeight& WMesh=getMesh(meshName);
+  // XML image data with raw appended values
+  if (FName.size()>4 && FName.substr(FName.size()-4)==".vti")
+    {
+      std::ofstream OX(FName.c_str(),std::ios::out | std::ios::binary);
+      WMesh.writeVTI(OX,EIndex,logFlag);
+      return;
+    }
+
+  std::ofstream OX(FName.c_str());
   const Geometry::BasicMesh3D& Grid=WMesh.getGeomGrid();
 
   // const long int XSize=WMesh.getXSize();
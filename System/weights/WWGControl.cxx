@@ -33,6 +33,8 @@
 #include <algorithm>
 #include <memory>
 #include <array>
+#include <atomic>
+#include <functional>
 
 #include "Exception.h"
 #include "FileReport.h"
@@ -62,6 +64,8 @@
 #include "meshConstruct.h"
 
 #include "BasicMesh3D.h"
+#include "AttnTable.h"
+#include "TrackCache.h"
 #include "WWGWeight.h"
 #include "MarkovProcess.h"
 #include "WWG.h"
@@ -445,7 +449,13 @@ WWGControl::wwgCreate(const Simulation& System,
 	    "       ScaleFactor [default: 1.0] \n"
 	    "       densityFactor [default: 1.0] \n"
 	    "       r2Length factor [default: 1.0] \n"
-	    "       r2Power [default: 2.0] \n"<<ELog::endCrit;
+	    "       r2Power [default: 2.0] \n"
+	    "       octree [keyword: use adaptive tracking] \n"
+	    "         threshold [log step to split : default 2.0]\n"
+	    "         initDepth [default: 2] \n"
+	    "         maxDepth [default: log2(max mesh size) : \n"
+	    "                   capped per axis by log2(axis size)] \n"
+	    <<ELog::endCrit;
 	  return;
 	}
 
@@ -475,6 +485,29 @@ WWGControl::wwgCreate(const Simulation& System,
 
       const Geometry::BasicMesh3D& mUnit=getGrid(meshGrid);
 
+      // optional adaptive octree tracking
+      bool octFlag(0);
+      double threshold(2.0);
+      size_t initDepth(2);
+      size_t maxDepth(0);
+      if (IParam.itemCnt(wKey,iSet)>index)
+	{
+	  const std::string octName=
+	    IParam.getValue<std::string>(wKey,iSet,index++);
+	  if (octName!="octree" && octName!="Octree")
+	    throw ColErr::InContainerError<std::string>
+	      (octName,"wwgCreate keyword");
+	  octFlag=1;
+	  const size_t NMax=std::max({mUnit.getXSize(),
+				      mUnit.getYSize(),
+				      mUnit.getZSize()});
+	  const size_t defDepth=static_cast<size_t>
+	    (std::ceil(std::log2(static_cast<double>(NMax))));
+	  threshold=IParam.getDefValue<double>(2.0,wKey,iSet,index++);
+	  initDepth=IParam.getDefValue<size_t>(2,wKey,iSet,index++);
+	  maxDepth=IParam.getDefValue<size_t>(defDepth,wKey,iSet,index++);
+	}
+
       size_t eIndex; // value to get a [index+1] into: 0 means no [] 
       const std::vector<double>& eUnit=
 	getEnergy(energyGrid,eIndex);
@@ -491,7 +524,11 @@ WWGControl::wwgCreate(const Simulation& System,
 	{	
 	  const Geometry::Plane& planeRef=getPlanePoint(sourceName);
 	  WWGWeight& wSet=wwg.getMesh(meshName);
-	  wSet.wTrack(System,planeRef,eIndex,density,r2Length,r2Power);
+	  if (octFlag)
+	    wSet.octreeTrack(System,planeRef,eIndex,density,r2Length,
+			     r2Power,threshold,initDepth,maxDepth);
+	  else
+	    wSet.wTrack(System,planeRef,eIndex,density,r2Length,r2Power);
 	}
       else if (hasSourcePoint(sourceName))
         {
@@ -500,7 +537,11 @@ WWGControl::wwgCreate(const Simulation& System,
 	  ELog::EM<<"MESH = "<<energyGrid<<" "<<eIndex<<" "<<meshName
 		  <<":"<<sourceRef<<ELog::endDiag;
 
-	  wSet.wTrack(System,sourceRef,eIndex,density,r2Length,r2Power);
+	  if (octFlag)
+	    wSet.octreeTrack(System,sourceRef,eIndex,density,r2Length,
+			     r2Power,threshold,initDepth,maxDepth);
+	  else
+	    wSet.wTrack(System,sourceRef,eIndex,density,r2Length,r2Power);
         }
       else 
 	throw ColErr::InContainerError<std::string>
@@ -541,15 +582,19 @@ WWGControl::wwgMarkov(const Simulation& System,
 	IParam.getDefValue<double>(1.0,wKey,iSet,index++);
       const double r2Power=
 	IParam.getDefValue<double>(2.0,wKey,iSet,index++);
+      const double maxRadius=
+	IParam.getDefValue<double>(0.0,wKey,iSet,index++);
       
-      if (nMarkov)
+      if (nMult)
 	{
 	  MarkovProcess MCalc;
+	  MCalc.setMaxRadius(maxRadius);
 	  MCalc.initializeData(wwg,wwg.getDefUnit());
 	  MCalc.computeMatrix(System,wwg,wwg.getDefUnit(),
 			      density,r2Length,r2Power);
 	  MCalc.multiplyOut(nMult);
-	  MCalc.rePopulateWWG();
+	  MCalc.rePopulateWWG(wwg,wwg.getDefUnit());
+	  nMarkov+=nMult;
 	  ELog::EM<<"MARKOV FINISHED"<<ELog::endDiag;
 	}
     }
@@ -803,8 +848,13 @@ WWGControl::processWeights(Simulation& System,
 
   if (IParam.flag("wWWG"))
     {
+      WM.getWWG().setBinaryOut(IParam.flag("wwgBinary"));
       System.populateCells();
       System.createObjSurfMap();
+      ModelSupport::AttnTable& AT=ModelSupport::AttnTable::Instance();
+      AT.setEnergyScale(IParam.flag("wAttnE"));
+      AT.build();
+      TrackCache::Instance().clear();
 
       procSourcePoint(System,IParam);
       procPlanePoint(System,IParam);
@@ -815,6 +865,7 @@ WWGControl::processWeights(Simulation& System,
       wwgMarkov(System,IParam);
       wwgCADIS(System,IParam);
       wwgNormalize(IParam);
+      TrackCache::Instance().clear();
 
       wwgActivate(System,IParam);
       wwgVTK(IParam);	    
@@ -0,0 +1,390 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   weights/WWGOctree.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <set>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <array>
+
+#include "Exception.h"
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "Vec3D.h"
+#include "dataSlice.h"
+#include "multiData.h"
+#include "BasicMesh3D.h"
+#include "threadSupport.h"
+#include "WWGWeight.h"
+#include "WWGOctree.h"
+
+namespace WeightSystem
+{
+
+WWGOctree::WWGOctree(const size_t nE,const size_t MD,
+		     const double T) :
+  NE(nE),maxDepth(MD),axisDepth({MD,MD,MD}),threshold(T),nEval(0)
+  /*!
+    Constructor
+    \param nE :: Number of values per node
+    \param MD :: Maximum depth
+    \param T :: Refinement threshold [log step]
+  */
+{}
+
+WWGOctree::WWGOctree(const WWGOctree& A) : 
+  NE(A.NE),maxDepth(A.maxDepth),axisDepth(A.axisDepth),
+  threshold(A.threshold),
+  Nodes(A.Nodes),Values(A.Values),nEval(A.nEval)
+  /*!
+    Copy constructor
+    \param A :: WWGOctree to copy
+  */
+{}
+
+WWGOctree&
+WWGOctree::operator=(const WWGOctree& A)
+  /*!
+    Assignment operator
+    \param A :: WWGOctree to copy
+    \return *this
+  */
+{
+  if (this!=&A)
+    {
+      NE=A.NE;
+      maxDepth=A.maxDepth;
+      axisDepth=A.axisDepth;
+      threshold=A.threshold;
+      Nodes=A.Nodes;
+      Values=A.Values;
+      nEval=A.nEval;
+    }
+  return *this;
+}
+
+size_t
+WWGOctree::getNLeaf() const
+  /*!
+    Count the leaves
+    \return number of leaf nodes
+  */
+{
+  return static_cast<size_t>
+    (std::count_if(Nodes.begin(),Nodes.end(),
+		   [](const octNode& N) { return N.child==0; }));
+}
+
+void
+WWGOctree::setAxisDepth(const std::array<size_t,3>& AD)
+  /*!
+    Set the max number of splits along each axis
+    \param AD :: Depth for x/y/z [capped at maxDepth]
+  */
+{
+  for(size_t i=0;i<3;i++)
+    axisDepth[i]=std::min(AD[i],maxDepth);
+  return;
+}
+
+size_t
+WWGOctree::splitAxes(const size_t index) const
+  /*!
+    Determine the axes a node can still be split along
+    \param index :: Node
+    \return mask of axes [bit 0:x 1:y 2:z]
+  */
+{
+  const octNode& N=Nodes[index];
+  if (N.depth>=maxDepth) return 0;
+  size_t mask(0);
+  for(size_t axis=0;axis<3;axis++)
+    if (N.axisLevel[axis]<axisDepth[axis])
+      mask |= (1UL << axis);
+  return mask;
+}
+
+size_t
+WWGOctree::split(const size_t index)
+  /*!
+    Split a leaf into 2/4/8 children [appended] along
+    the axes that have not reached their depth
+    \param index :: Node to split
+    \return number of children [0 if not split]
+  */
+{
+  const size_t mask=splitAxes(index);
+  if (!mask) return 0;
+  
+  const Geometry::Vec3D LPt=Nodes[index].lowPt;
+  const Geometry::Vec3D HPt=Nodes[index].highPt;
+  const Geometry::Vec3D MPt=(LPt+HPt)/2.0;
+  const size_t D=Nodes[index].depth+1;
+  std::array<size_t,3> AL=Nodes[index].axisLevel;
+  for(size_t axis=0;axis<3;axis++)
+    if (mask & (1UL << axis)) AL[axis]++;
+
+  // axes of the mask in x,y,z order
+  std::vector<size_t> axes;
+  for(size_t axis=0;axis<3;axis++)
+    if (mask & (1UL << axis))
+      axes.push_back(axis);
+  
+  Nodes[index].splitMask=mask;
+  Nodes[index].child=Nodes.size();
+  for(size_t sub=0;sub<(1UL << axes.size());sub++)
+    {
+      octNode CN;
+      CN.lowPt=LPt;
+      CN.highPt=HPt;
+      for(size_t i=0;i<axes.size();i++)
+	{
+	  if (sub & (1UL << i))
+	    CN.lowPt[axes[i]]=MPt[axes[i]];
+	  else
+	    CN.highPt[axes[i]]=MPt[axes[i]];
+	}
+      CN.depth=D;
+      CN.axisLevel=AL;
+      CN.splitMask=0;
+      CN.child=0;
+      Nodes.push_back(CN);
+    }
+  return 1UL << axes.size();
+}
+
+void
+WWGOctree::evaluate(const std::vector<size_t>& nodeList,
+		    const size_t nThreads,const FTYPE& Func)
+  /*!
+    Evaluate the centre value of a set of nodes
+    \param nodeList :: Nodes to evaluate
+    \param nThreads :: Threads to use
+    \param Func :: log weight function
+  */
+{
+  ELog::RegMethod RegA("WWGOctree","evaluate");
+
+  Values.resize(Nodes.size()*NE,0.0);
+  threadSupport::parallelLoop
+    (nThreads,nodeList.size(),
+     [&](const size_t i)
+     {
+       const size_t index=nodeList[i];
+       const octNode& N=Nodes[index];
+       const std::vector<double> V=Func((N.lowPt+N.highPt)/2.0);
+       if (V.size()!=NE)
+	 throw ColErr::MisMatch<size_t>(V.size(),NE,"Function size");
+       std::copy(V.begin(),V.end(),Values.begin()+
+		 static_cast<long int>(index*NE));
+     });
+  nEval+=nodeList.size();
+  return;
+}
+
+size_t
+WWGOctree::findLeaf(const Geometry::Vec3D& Pt) const
+  /*!
+    Find the leaf containing a point
+    \param Pt :: Point
+    \return leaf index / Nodes.size() if outside
+  */
+{
+  if (Nodes.empty()) return 0;
+  const octNode& Root=Nodes[0];
+  if (Pt.X()<Root.lowPt.X() || Pt.X()>Root.highPt.X() ||
+      Pt.Y()<Root.lowPt.Y() || Pt.Y()>Root.highPt.Y() ||
+      Pt.Z()<Root.lowPt.Z() || Pt.Z()>Root.highPt.Z())
+    return Nodes.size();
+
+  size_t index(0);
+  while(Nodes[index].child)
+    {
+      const octNode& N=Nodes[index];
+      const Geometry::Vec3D MPt=(N.lowPt+N.highPt)/2.0;
+      size_t sub(0);
+      size_t bit(0);
+      for(size_t axis=0;axis<3;axis++)
+	if (N.splitMask & (1UL << axis))
+	  {
+	    if (Pt[axis]>=MPt[axis])
+	      sub |= (1UL << bit);
+	    bit++;
+	  }
+      index=N.child+sub;
+    }
+  return index;
+}
+
+const double*
+WWGOctree::getValue(const Geometry::Vec3D& Pt) const
+  /*!
+    Get the leaf values at a point
+    \param Pt :: Point
+    \return pointer to NE values / 0 if outside
+  */
+{
+  const size_t index=findLeaf(Pt);
+  return (index<Nodes.size()) ? Values.data()+index*NE : 0;
+}
+
+bool
+WWGOctree::needsRefine(const size_t index) const
+  /*!
+    Determine if a leaf differs by more than the threshold
+    from any of its face neighbours
+    \param index :: Leaf node
+    \return true if it should be split
+  */
+{
+  const octNode& N=Nodes[index];
+  if (N.child || !splitAxes(index)) return 0;
+
+  const Geometry::Vec3D CPt=(N.lowPt+N.highPt)/2.0;
+  const Geometry::Vec3D HalfPt=(N.highPt-N.lowPt)/2.0;
+  const double* VPt=Values.data()+index*NE;
+
+  for(size_t axis=0;axis<3;axis++)
+    for(const double sign : {-1.0,1.0})
+      {
+	Geometry::Vec3D Probe(CPt);
+	Probe[axis]+=sign*HalfPt[axis]*(1.0+1e-6);
+	const size_t NIndex=findLeaf(Probe);
+	if (NIndex<Nodes.size())
+	  {
+	    const double* NPt=Values.data()+NIndex*NE;
+	    for(size_t e=0;e<NE;e++)
+	      if (std::abs(VPt[e]-NPt[e])>threshold)
+		return 1;
+	  }
+      }
+  return 0;
+}
+  
+void
+WWGOctree::build(const Geometry::Vec3D& lowPt,
+		 const Geometry::Vec3D& highPt,
+		 const size_t initDepth,
+		 const size_t nThreads,
+		 const FTYPE& Func)
+  /*!
+    Build the tree : uniform to initDepth then refined until
+    no leaf needs splitting
+    \param lowPt :: Low corner
+    \param highPt :: High corner
+    \param initDepth :: Uniform starting depth
+    \param nThreads :: Threads for evaluation
+    \param Func :: log weight function [thread safe]
+  */
+{
+  ELog::RegMethod RegA("WWGOctree","build");
+
+  Nodes.clear();
+  Values.clear();
+  nEval=0;
+
+  octNode Root;
+  Root.lowPt=lowPt;
+  Root.highPt=highPt;
+  Root.depth=0;
+  Root.axisLevel={0,0,0};
+  Root.splitMask=0;
+  Root.child=0;
+  Nodes.push_back(Root);
+
+  // uniform levels : nodes limited on all axes stay as leaves
+  std::vector<size_t> leafList({0});
+  for(size_t D=0;D<initDepth;D++)
+    {
+      std::vector<size_t> nextList;
+      for(const size_t index : leafList)
+	{
+	  const size_t nChild=split(index);
+	  for(size_t i=0;i<nChild;i++)
+	    nextList.push_back(Nodes[index].child+i);
+	  if (!nChild)
+	    nextList.push_back(index);
+	}
+      leafList=std::move(nextList);
+    }
+  evaluate(leafList,nThreads,Func);
+
+  std::vector<size_t> refineList;
+  do
+    {
+      refineList.clear();
+      for(size_t i=0;i<Nodes.size();i++)
+	if (needsRefine(i))
+	  refineList.push_back(i);
+
+      const size_t firstNew=Nodes.size();
+      for(const size_t index : refineList)
+	split(index);
+      std::vector<size_t> newList;
+      for(size_t i=firstNew;i<Nodes.size();i++)
+	newList.push_back(i);
+      evaluate(newList,nThreads,Func);
+    } while(!refineList.empty());
+
+  ELog::EM<<"Octree : "<<getNLeaf()<<" leaves from "
+	  <<nEval<<" evaluations"<<ELog::endDiag;
+  return;
+}
+
+void
+WWGOctree::resample(WWGWeight& WMesh,
+		    const std::vector<size_t>& EIndex) const
+  /*!
+    Add the leaf values to each point of a rectilinear mesh
+    \param WMesh :: Mesh to add to [log space]
+    \param EIndex :: Mesh energy bin for each value
+  */
+{
+  ELog::RegMethod RegA("WWGOctree","resample");
+
+  if (EIndex.size()!=NE)
+    throw ColErr::MisMatch<size_t>(EIndex.size(),NE,"EIndex size");
+
+  const Geometry::BasicMesh3D& Grid=WMesh.getGeomGrid();
+  size_t cN(0);
+  for(size_t i=0;i<Grid.getXSize();i++)
+    for(size_t j=0;j<Grid.getYSize();j++)
+      for(size_t k=0;k<Grid.getZSize();k++)
+	{
+	  const double* VPt=getValue(Grid.point(i,j,k));
+	  if (VPt)
+	    for(size_t e=0;e<NE;e++)
+	      WMesh.addLogPoint(cN,EIndex[e],VPt[e]);
+	  cN++;
+	}
+  return;
+}
+
+}  // NAMESPACE WeightSystem
@@ -32,6 +32,8 @@
 #include <algorithm>
 #include <memory>
 #include <array>
+#include <functional>
+#include <atomic>
 #include <format>
 
 #include "Exception.h"
@@ -51,6 +53,7 @@
 #include "Plane.h"
 #include "support.h"
 #include "writeSupport.h"
+#include "vtiWriter.h"
 #include "BaseMap.h"
 #include "LineUnit.h"
 #include "LineTrack.h"
@@ -59,7 +62,17 @@
 #include "ObjectTrackPlane.h"
 #include "phitsWriteSupport.h"
 #include "particleConv.h"
+#include "varList.h"
+#include "Code.h"
+#include "FuncDataBase.h"
+#include "groupRange.h"
+#include "objectGroups.h"
+#include "Simulation.h"
+#include "SimTrack.h"
+#include "threadSupport.h"
+#include "TrackCache.h"
 #include "WWGWeight.h"
+#include "WWGOctree.h"
 
 namespace WeightSystem
 {
@@ -334,6 +347,33 @@ WWGWeight::scalePower(const double powerFactor)
   return;
 }
   
+void
+WWGWeight::setLogPoint(const size_t index,
+		       const size_t IE,
+		       const double V)
+/*!
+    Set a point assuming x,y,z indexing and z fastest point
+    \param index :: index for linearization
+    \param IE :: Energy bin
+    \param V :: value to set [LOG VALUE]
+  */
+{
+  const size_t IX=index/(WY*WZ);
+  const size_t IY=(index/WZ) % WY;
+  const size_t IZ=index % WZ;
+
+  if (IX>=WX)
+    throw ColErr::IndexError<size_t>
+      (index,WX,"WWGWeight::setLogPoint::Index out of range");
+
+  if (IE>=WE)
+    throw ColErr::IndexError<size_t>
+      (IE,WE,"WWGWeight::setLogPoint::eIndex out of range");
+
+  WGrid.get()[IE][IX][IY][IZ]=(V>0.0) ? 0.0 : V;
+  return;
+}
+
 void
 WWGWeight::addLogPoint(const size_t index,
 		       const size_t IE,
@@ -561,9 +601,11 @@ WWGWeight::wTrack(const Simulation& System,
 		  const double r2Length,
 		  const double r2Power)
   /*!
-    Calculate a specific track from sourcePoint to position
+    Calculate a specific track from sourcePoint to position.
+    The grid points are split over System.getThreads() threads
     \param System :: Simulation to use    
     \param initPt :: Point for outgoing track
+    \param eIndex :: Energy bin [0 for all / index+1]
     \param densityFactor :: Scaling factor for density
     \param r2Length :: scale factor for length
     \param r2Power :: power of 1/r^2 factor
@@ -571,31 +613,110 @@ WWGWeight::wTrack(const Simulation& System,
 {
   ELog::RegMethod RegA("WWGWeight","wTrack");
 
-  size_t cN(0);
-
-  //ELog::EM<<"Processing  "<<MidPt.size()<<" for WWG"<<ELog::endDiag;
+  // Energy bins to calculate : the track is energy independent
+  std::vector<size_t> EIndex;
+  std::vector<double> EVal;
+  for(size_t index=0;index<WE;index++)
+    if (!eIndex || index+1==eIndex)
+      {
+	EIndex.push_back(index);
+	EVal.push_back((EBin[index]+EBin[index+1])/2.0);
+      }
+  if (EIndex.empty()) return;
 
-  //  const size_t NCut(WE*WX*WY*WZ/5);
-  for(size_t i=0;i<WX;i++)
-    for(size_t j=0;j<WY;j++)
-      for(size_t k=0;k<WZ;k++)
+  // traces are kept for CADISnorm / later passes
+  TrackCache& TC=TrackCache::Instance();
+  TrackCache::PTYPE& PSet=
+    TC.getSet(TrackCache::makeKey(initPt,Grid),WX*WY*WZ);
+  
+  // Each grid point is an independent track and only writes its
+  // own WGrid entries and cache slot.
+  auto trackPoint=[&](const size_t cN)
+    {
+      trackPath& slot=PSet[cN];
+      std::vector<double> DT;
+      if (slot.set)
+	DT=pathWeight(slot,EVal,densityFactor,r2Length,r2Power);
+      else
 	{
-	  const Geometry::Vec3D Pt=Grid.point(i,j,k);
-	  for(size_t index=0;index<WE;index++)
-	    {
-	      if (!eIndex || static_cast<size_t>(index+1)==eIndex)
-		{
-		  const size_t sIndex(static_cast<size_t>(index));
-		  const double EVal=(EBin[sIndex]+EBin[sIndex+1])/2.0;
-		  const double DT=
-		    distTrack(System,initPt,EVal,Pt,
-			      densityFactor,r2Length,r2Power);
-		  // energy
-		  addLogPoint(cN,index,DT);
-		}
-	    }
-	  cN++;
+	  const size_t i=cN/(WY*WZ);
+	  const size_t j=(cN/WZ) % WY;
+	  const size_t k=cN % WZ;
+	  trackPath path;
+	  tracePath(System,initPt,Grid.point(i,j,k),path);
+	  DT=pathWeight(path,EVal,densityFactor,r2Length,r2Power);
+	  TC.store(slot,path);
 	}
+      for(size_t index=0;index<EIndex.size();index++)
+	addLogPoint(cN,EIndex[index],DT[index]);
+    };
+
+  threadSupport::parallelLoop(System.getThreads(),WX*WY*WZ,trackPoint);
+  return;
+}
+
+
+template<typename T>
+void
+WWGWeight::octreeTrack(const Simulation& System,
+		       const T& initPt,
+		       const size_t eIndex,
+		       const double densityFactor,
+		       const double r2Length,
+		       const double r2Power,
+		       const double threshold,
+		       const size_t initDepth,
+		       const size_t maxDepth)
+  /*!
+    Calculate the track weights on an adaptive octree over
+    the mesh volume. Leaves are only split where the log weight
+    changes by more than threshold, so uniform regions need far
+    fewer traces. The tree is resampled on to the mesh.
+    \param System :: Simulation to use    
+    \param initPt :: Point for outgoing track
+    \param eIndex :: Energy bin [0 for all / index+1]
+    \param densityFactor :: Scaling factor for density
+    \param r2Length :: scale factor for length
+    \param r2Power :: power of 1/r^2 factor
+    \param threshold :: log step to force a split
+    \param initDepth :: uniform starting depth
+    \param maxDepth :: max depth of refinement [further
+    limited per axis by the mesh size on that axis]
+  */
+{
+  ELog::RegMethod RegA("WWGWeight","octreeTrack");
+
+  std::vector<size_t> EIndex;
+  std::vector<double> EVal;
+  for(size_t index=0;index<WE;index++)
+    if (!eIndex || index+1==eIndex)
+      {
+	EIndex.push_back(index);
+	EVal.push_back((EBin[index]+EBin[index+1])/2.0);
+      }
+  if (EIndex.empty()) return;
+
+  auto trackFunc=[&](const Geometry::Vec3D& Pt) -> std::vector<double>
+    {
+      return distTrack(System,initPt,EVal,Pt,
+		       densityFactor,r2Length,r2Power);
+    };
+
+  // stop splitting an axis once a leaf spans one mesh cell
+  std::array<size_t,3> axisDepth;
+  const size_t NPts[3]={WX,WY,WZ};
+  for(size_t i=0;i<3;i++)
+    axisDepth[i]=static_cast<size_t>
+      (std::ceil(std::log2(static_cast<double>(NPts[i]))));
+  
+  WWGOctree OTree(EIndex.size(),maxDepth,threshold);
+  OTree.setAxisDepth(axisDepth);
+  OTree.build(Grid.getLow(),Grid.getHigh(),initDepth,
+	      System.getThreads(),trackFunc);
+  OTree.resample(*this,EIndex);
+
+  ELog::EM<<"Octree traces "<<OTree.getNEval()<<" for "
+	  <<WX*WY*WZ<<" mesh points"<<ELog::endDiag;
   return;
 }
 
@@ -638,6 +759,92 @@ WWGWeight::distTrack(const Simulation& System,
 }
 
 
+template<typename T>
+void
+WWGWeight::tracePath(const Simulation& System,
+		     const T& aimPt,
+		     const Geometry::Vec3D& gridPt,
+		     trackPath& path) const
+  /*!
+    Trace from a grid point to the source. The last-cell 
+    cache is reset first so the result does not depend 
+    on the order points are processed.
+    \param System :: Simulation to use    
+    \param aimPt :: Point for outgoing track
+    \param gridPt :: Grid points
+    \param path :: path to fill
+  */
+{
+  ELog::RegMethod RegA("WWGWeight","tracePath");
+
+  typedef typename std::conditional<
+    std::is_same<T,Geometry::Plane>::value,
+    ModelSupport::ObjectTrackPlane,
+    ModelSupport::ObjectTrackPoint>::type TrackType;
+
+  ModelSupport::SimTrack::Instance().setCell(&System,0);
+  TrackType OTrack(aimPt);
+  OTrack.addUnit(System,1,gridPt);
+  path.fill(OTrack.getLine(1));
+  return;
+}
+
+std::vector<double>
+WWGWeight::pathWeight(const trackPath& path,
+		      const std::vector<double>& EVec,
+		      const double densityFactor,
+		      const double r2Length,
+		      const double r2Power) const
+  /*!
+    Calculate the log weight of a path for a set of energies
+    \param path :: Traced path
+    \param EVec :: Central energy of each bin [MeV]
+    \param densityFactor :: Scaling factor for density
+    \param r2Length :: scale factor for length
+    \param r2Power :: power of 1/r^2 factor
+    \return log weight for each energy
+  */
+{
+  double DistT=path.distance*r2Length;
+  if (DistT<1.0) DistT=1.0;
+  const double R2=r2Power*log(DistT);
+
+  std::vector<double> Out=path.attnSum(EVec);
+  for(double& AT : Out)
+    AT= -densityFactor*AT-R2;
+  return Out;
+}
+
+template<typename T>
+std::vector<double>
+WWGWeight::distTrack(const Simulation& System,
+		     const T& aimPt,
+		     const std::vector<double>& EVec,
+		     const Geometry::Vec3D& gridPt,
+		     const double densityFactor,
+		     const double r2Length,
+		     const double r2Power) const
+  /*!
+    Calculate a specific track from sourcePoint to position
+    for a set of energies from a single trace
+    \param System :: Simulation to use    
+    \param aimPt :: Point for outgoing track
+    \param EVec :: Central energy of each bin [MeV]
+    \param gridPt :: Grid points
+    \param densityFactor :: Scaling factor for density
+    \param r2Length :: scale factor for length
+    \param r2Power :: power of 1/r^2 factor
+    \return log weight for each energy
+  */
+{
+  ELog::RegMethod RegA("WWGWeight","distTrack(vec)");
+
+  trackPath path;
+  tracePath(System,aimPt,gridPt,path);
+  return pathWeight(path,EVec,densityFactor,r2Length,r2Power);
+}
+
+
 template<typename T,typename U>
 void
 WWGWeight::CADISnorm(const Simulation& System,
@@ -699,16 +906,39 @@ WWGWeight::CADISnorm(const Simulation& System,
   double sumR=minLOG;
   double sumRA=minLOG;
   const double EVal=(EBin[mIndex]+EBin[mIndex+1])/2.0;  
+
+  // source traces from wTrack [if the same source/mesh] are reused
+  TrackCache& TC=TrackCache::Instance();
+  TrackCache::PTYPE& PSet=
+    TC.getSet(TrackCache::makeKey(sourcePt,Grid),WX*WY*WZ);
+  const std::vector<double> EVec({EVal});
+  std::vector<double> WVec(WX*WY*WZ);
+  auto trackPoint=[&](const size_t cN)
+    {
+      trackPath& slot=PSet[cN];
+      if (slot.set)
+	WVec[cN]=pathWeight(slot,EVec,densityFactor,r2Length,r2Power)[0];
+      else
+	{
+	  const size_t i=cN/(WY*WZ);
+	  const size_t j=(cN/WZ) % WY;
+	  const size_t k=cN % WZ;
+	  trackPath path;
+	  tracePath(System,sourcePt,Grid.point(i,j,k),path);
+	  WVec[cN]=
+	    pathWeight(path,EVec,densityFactor,r2Length,r2Power)[0];
+	  TC.store(slot,path);
+	}
+    };
+  threadSupport::parallelLoop(System.getThreads(),WX*WY*WZ,trackPoint);
+
   // STILL in log space
+  size_t cN(0);
   for(size_t i=0;i<WX;i++)
     for(size_t j=0;j<WY;j++)
       for(size_t k=0;k<WZ;k++)
 	{
-	  const Geometry::Vec3D gridPt=Grid.point(i,j,k);
-
-	  const double W=
-	    distTrack(System,sourcePt,EVal,gridPt,
-		      densityFactor,r2Length,r2Power);
+	  const double W=WVec[cN++];
 	      
 	  sumR=(i*j*k != 0) ?
 	    mathFunc::logAdd(sumR,Source.WGrid.get()[sIndex][i][j][k]+W) :
@@ -766,10 +996,10 @@ WWGWeight::writeVTK(std::ostream& OX,
 	for(size_t I=0;I<WX;I++)
 	  {
 	    if (!logFlag)
-	      OX<<std::format(":<11.6g    ",
+	      OX<<std::format("{:<11.6g}    ",
 			      std::exp(WGrid.get()[EIndex][I][J][K]));	
 	    else
-	      OX<<std::format(":<11.6g    ",
+	      OX<<std::format("{:<11.6g}    ",
 			      -WGrid.get()[EIndex][I][J][K]);	
 
 	    if (WGrid.get()[EIndex][I][J][K]<wMin)
@@ -794,6 +1024,54 @@ WWGWeight::writeVTK(std::ostream& OX,
   return;
 }
 
+void
+WWGWeight::writeVTI(std::ostream& OX,
+		    const size_t EIndex,
+		    const bool logFlag) const
+  /*!
+    Write out the VTK XML image data format with the 
+    values as a single raw appended Float32 block
+    \param OX :: Output stream [binary]
+    \param EIndex :: energy index
+    \param logFlag :: Convert power to log space
+  */
+{
+  ELog::RegMethod RegA("WWGWeight","writeVTI");
+  
+  if (EIndex>=WE)
+    throw ColErr::IndexError<size_t>(EIndex,WE,"index in WMesh.ESize");
+
+  const size_t NXYZ(WX*WY*WZ);
+  const std::vector<double>& WData=WGrid.getVector();
+  const double* WPtr=WData.data()+EIndex*NXYZ;
+
+  std::vector<double> Out(NXYZ);
+  double wMin(1e80),wMax(-1e80);
+  for(size_t i=0;i<NXYZ;i++)
+    {
+      const double W=WPtr[i];
+      Out[i]=(logFlag) ? -W : std::exp(W);
+      if (W<wMin) wMin=W;
+      if (W>wMax) wMax=W;
+    }
+
+  // uniform mesh : spacing is the bin width
+  const Geometry::Vec3D Span=Grid.getHigh()-Grid.getLow();
+  const Geometry::Vec3D Origin(Grid.getXCoordinate(0),
+			       Grid.getYCoordinate(0),
+			       Grid.getZCoordinate(0));
+  const Geometry::Vec3D Spacing(Span.X()/static_cast<double>(WX),
+				Span.Y()/static_cast<double>(WY),
+				Span.Z()/static_cast<double>(WZ));
+
+  StrFunc::vtiWriter VTI({WX,WY,WZ},Origin,Spacing);
+  VTI.addArray("weight",Out);
+  VTI.write(OX);
+
+  ELog::EM<<"WWG["<<ID<<"]["<<EIndex<<"] "<<wMin<<" "<<wMax<<ELog::endDiag;  
+  return;
+}
+
 void
 WWGWeight::write(std::ostream& OX) const
   /*!
@@ -985,6 +1263,49 @@ WWGWeight::writeWWINP(std::ostream& OX) const
   return;
 }
 
+void
+WWGWeight::writeWWINPBinary(std::ostream& OX) const
+  /*!
+    Write out the wwinp data as a binary block :
+     - char[8] "CLWWINP1"
+     - uint64 : nParticle, nEnergy, WE, WX, WY, WZ
+     - double[6] : low / high corners
+     - double[nEnergy] : energy bins
+     - double[WE*WX*WY*WZ] : weights in wwinp order [X fastest]
+    \param OX :: Output stream [binary]
+   */
+{
+  ELog::RegMethod RegA("WWGWeight","writeWWINPBinary");
+  
+  const char magic[8]={'C','L','W','W','I','N','P','1'};
+  const std::vector<uint64_t> Head=
+    { particles.size(),EBin.size(),WE,WX,WY,WZ };
+  const Geometry::Vec3D& LPt=Grid.getLow();
+  const Geometry::Vec3D& HPt=Grid.getHigh();
+  std::vector<double> Bounds=
+    { LPt.X(),LPt.Y(),LPt.Z(),HPt.X(),HPt.Y(),HPt.Z() };
+  Bounds.insert(Bounds.end(),EBin.begin(),EBin.end());
+
+  const size_t NXYZ(WX*WY*WZ);
+  const std::vector<double>& WData=WGrid.getVector();
+  std::vector<double> Out(WE*NXYZ);
+  size_t index(0);
+  for(size_t EI=0;EI<WE;EI++)
+    for(size_t I=0;I<WX;I++)
+      for(size_t J=0;J<WY;J++)
+	for(size_t K=0;K<WZ;K++)
+	  Out[EI*NXYZ+(K*WY+J)*WX+I]=std::exp(WData[index++]);
+
+  OX.write(magic,8);
+  OX.write(reinterpret_cast<const char*>(Head.data()),
+	   static_cast<std::streamsize>(Head.size()*sizeof(uint64_t)));
+  OX.write(reinterpret_cast<const char*>(Bounds.data()),
+	   static_cast<std::streamsize>(Bounds.size()*sizeof(double)));
+  OX.write(reinterpret_cast<const char*>(Out.data()),
+	   static_cast<std::streamsize>(Out.size()*sizeof(double)));
+  return;
+}
+
 void
 WWGWeight::writeGrid(std::ostream& OX) const
   /*!
@@ -1025,6 +1346,19 @@ double WWGWeight::distTrack(const Simulation&,const Geometry::Vec3D&,
 			    const double,const double,
 			    const double) const;
 
+template
+std::vector<double>
+WWGWeight::distTrack(const Simulation&,const Geometry::Plane&,
+		     const std::vector<double>&,const Geometry::Vec3D&,
+		     const double,const double,
+		     const double) const;
+template
+std::vector<double>
+WWGWeight::distTrack(const Simulation&,const Geometry::Vec3D&,
+		     const std::vector<double>&,const Geometry::Vec3D&,
+		     const double,const double,
+		     const double) const;
+
 template
 void WWGWeight::wTrack(const Simulation&,const Geometry::Vec3D&,
 		       const size_t,const double,const double,
@@ -1035,6 +1369,18 @@ void WWGWeight::wTrack(const Simulation&,const Geometry::Plane&,
 		       const size_t,const double,const double,
 		       const double);
 
+template
+void WWGWeight::octreeTrack(const Simulation&,const Geometry::Vec3D&,
+			    const size_t,const double,const double,
+			    const double,const double,const size_t,
+			    const size_t);
+
+template
+void WWGWeight::octreeTrack(const Simulation&,const Geometry::Plane&,
+			    const size_t,const double,const double,
+			    const double,const double,const size_t,
+			    const size_t);
+
 template 
 void WWGWeight::CADISnorm(const Simulation&,const size_t,
 			  const WWGWeight&,const size_t,
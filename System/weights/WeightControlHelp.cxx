@@ -84,9 +84,13 @@ WeightControl::help()
   ELog::EM<<"-- wWWG --::"<<ELog::endDiag;
   ELog::EM<<"-- wwgNorm -- minWeight power :: 10^-minWeight and w=w^power "<<ELog::endDiag;
   ELog::EM<<"-- wwgCalc --::"<<ELog::endDiag;
-  ELog::EM<<"-- wwgMarkov --::"<<ELog::endDiag;
+  ELog::EM<<"-- wwgMarkov -- nIter density r2Length r2Power maxRadius"
+	  <<" [0: 10 mesh steps] ::"
+	  <<ELog::endDiag;
   ELog::EM<<"-- wwgRPtMesh -- set hte reference point for the mesh ::"<<ELog::endDiag;
-  ELog::EM<<"-- wwgVTK --::"<<ELog::endDiag;
+  ELog::EM<<"-- wwgVTK -- fileName mesh[eIndex] log :: .vti gives binary"
+	  <<ELog::endDiag;
+  ELog::EM<<"-- wwgBinary -- write wwinp.bin in place of wwinp"<<ELog::endDiag;
   procCalcHelp();
 
   ELog::EM<<"-- wFCL --:: Set forced collision"<<ELog::endDiag;
@@ -26,6 +26,11 @@
 
 class Simulation;
 
+namespace Geometry
+{
+  class BasicMesh3D;
+}
+
 namespace WeightSystem
 {
   class ItemWeight;
@@ -44,17 +49,33 @@ class MarkovProcess
 {
  private:
 
+  /// log transfer cut-off [below ignored]
+  static constexpr double cutValue=-20.0;
+  /// default coupling radius [mesh steps]
+  static constexpr size_t defShell=10;
   
   size_t nIteration;       ///< number of iterations
 
+  size_t WE;             ///< WE size of WWG [energy]
   size_t WX;             ///< WX size of WWG
   size_t WY;             ///< WY size of WWG 
   size_t WZ;             ///< WZ size of WWG
 
   size_t FSize;          ///< size of fluxField [square]
+  /// max distance between coupled points [0:defShell steps]
+  double maxRadius;
+
+  /// CSR row start [FSize+1] into colIndex/fluxField [upper triangle]
+  std::vector<size_t> rowStart;
+  std::vector<size_t> colIndex;   ///< Column of each stored element
+  /// Transfer factor [initialCell][finalCell] for stored elements
+  std::vector<double> fluxField;
 
-  /// Array of interaction [initialCell][finalCell]
-  multiData<double> fluxField;
+  /// Flux at each point [energy][point] : linear
+  multiData<double> fluxVec;
+
+  void multiplyVec(const std::vector<double>&,
+		   std::vector<double>&) const;
   
  public:
 
@@ -63,13 +84,19 @@ class MarkovProcess
   MarkovProcess& operator=(const MarkovProcess&);
   ~MarkovProcess();
 
-
+  /// Set the coupling radius
+  void setMaxRadius(const double R) { maxRadius=R; }
+  /// Number of stored off-diagonal pairs
+  size_t getNElements() const { return fluxField.size(); }
+  
   void initializeData(const WWG&,const std::string&);
   void computeMatrix(const Simulation&,const WWG&,
 		     const std::string&,
 		     const double,const double,const double);
+  void buildMatrix(const size_t,const Geometry::BasicMesh3D&,
+		   const std::function<double(const size_t,const size_t)>&);
   void multiplyOut(const size_t);
-  void rePopulateWWG();
+  void rePopulateWWG(WWG&,const std::string&) const;
   
 };
 
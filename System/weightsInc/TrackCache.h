@@ -0,0 +1,125 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   weightsInc/TrackCache.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef WeightSystem_TrackCache_h
+#define WeightSystem_TrackCache_h
+
+namespace Geometry
+{
+  class Vec3D;
+  class Plane;
+  class BasicMesh3D;
+}
+
+namespace MonteCarlo
+{
+  class Material;
+}
+
+namespace ModelSupport
+{
+  class LineTrack;
+}
+
+namespace WeightSystem
+{
+
+/*!
+  \struct trackPath
+  \version 1.0
+  \author S. Ansell
+  \date October 2026
+  \brief Material segments of a single source-grid trace
+*/
+
+struct trackPath
+{
+  bool set;                      ///< Path is valid
+  double distance;               ///< Total track length
+  /// Non-void segments [material : length] in track order
+  std::vector<std::pair<const MonteCarlo::Material*,double>> segments;
+
+  trackPath() : set(0),distance(0.0) {}   ///< Constructor
+  void fill(const ModelSupport::LineTrack&);
+  std::vector<double> attnSum(const std::vector<double>&) const;
+};
+
+/*!
+  \class TrackCache
+  \version 1.0
+  \author S. Ansell
+  \date October 2026
+  \brief Stores source to grid-point traces for WWG meshes
+
+  Keyed by the source [point/plane] and the mesh geometry,
+  each set holds one trackPath per grid index. The set is
+  created serially; grid points may then be stored from
+  different threads as each index is only written once.
+  The total number of stored segments is bounded.
+*/
+
+class TrackCache
+{
+ public:
+
+  /// Storage of paths for each grid index
+  typedef std::vector<trackPath> PTYPE;
+  
+ private:
+
+  size_t maxSegment;                ///< Max segments to store
+  std::atomic<size_t> nSegment;     ///< Segments stored
+
+  /// Source/mesh key : paths
+  std::map<std::string,PTYPE> cacheMap;
+
+  TrackCache();
+
+  ///\cond SINGLETON
+  TrackCache(const TrackCache&);
+  TrackCache& operator=(const TrackCache&);
+  ///\endcond SINGLETON
+
+  static std::string meshKey(const Geometry::BasicMesh3D&);
+  
+ public:
+
+  static TrackCache& Instance();
+
+  static std::string makeKey(const Geometry::Vec3D&,
+			     const Geometry::BasicMesh3D&);
+  static std::string makeKey(const Geometry::Plane&,
+			     const Geometry::BasicMesh3D&);
+
+  /// Set the memory bound [number of segments]
+  void setMaxSegment(const size_t N) { maxSegment=N; }
+  /// Number of segments stored
+  size_t getNSegment() const { return nSegment; }
+  
+  void clear();
+  PTYPE& getSet(const std::string&,const size_t);
+  void store(trackPath&,trackPath&);
+
+};
+
+}
+
+#endif
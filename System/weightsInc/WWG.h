@@ -53,6 +53,7 @@ class WWG
   int mtime;                     ///< Flag to inditace energy(0)/time(1)
   int switchn;                   ///< read from wwinp file
   Geometry::Vec3D refPt;         ///< Reference point
+  bool binaryFlag;               ///< Write wwinp as binary
 
   std::string defUnit;           ///< Default unit
   MeshTYPE WMeshMap;             /// Map of meshes
@@ -73,6 +74,8 @@ class WWG
 
   /// accessor to default name
   const std::string& getDefUnit() const { return defUnit; }
+  /// Set binary wwinp output
+  void setBinaryOut(const bool B) { binaryFlag=B; }
   
 
   WWGWeight& createMesh(const std::string&);
@@ -96,6 +99,7 @@ class WWG
 
 
   void writeWWINP(const std::string&) const;
+  void writeWWINPBinary(const std::string&) const;
   void writeVTK(const std::string&,const bool,
 		const std::string&,const size_t =0) const;
 
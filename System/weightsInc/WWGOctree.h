@@ -0,0 +1,106 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   weightsInc/WWGOctree.h
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef WeightSystem_WWGOctree_h
+#define WeightSystem_WWGOctree_h
+
+namespace WeightSystem
+{
+  class WWGWeight;
+  
+/*!
+  \class WWGOctree
+  \version 1.0
+  \author S. Ansell
+  \date October 2026
+  \brief Adaptive octree of log-weights
+
+  Each leaf holds the log weight [per energy] at its centre.
+  Leaves are split while the step to a face neighbour exceeds
+  the threshold [in log space] and the leaf is above maxDepth.
+  Each axis has its own depth limit so a leaf is only halved
+  along the axes that are still wider than the limit [giving
+  2/4/8 children]. The values are resampled onto a rectilinear
+  WWGWeight mesh for output.
+*/
+
+class WWGOctree
+{
+ public:
+
+  /// Function giving the log weights at a point
+  typedef std::function<std::vector<double>(const Geometry::Vec3D&)> FTYPE;
+  
+ private:
+
+  /// Single cell of the tree
+  struct octNode
+  {
+    Geometry::Vec3D lowPt;     ///< Low corner
+    Geometry::Vec3D highPt;    ///< High corner
+    size_t depth;              ///< Refinement level [0 root]
+    std::array<size_t,3> axisLevel;  ///< Splits along each axis
+    size_t splitMask;          ///< Axes split [bit 0:x 1:y 2:z]
+    size_t child;              ///< First child [0 for leaf]
+  };
+  
+  size_t NE;                   ///< Values per node [energy bins]
+  size_t maxDepth;             ///< Max refinement level
+  std::array<size_t,3> axisDepth;  ///< Max splits along each axis
+  double threshold;            ///< Max log-weight step between leaves
+
+  std::vector<octNode> Nodes;  ///< Nodes [0 is root]
+  std::vector<double> Values;  ///< Centre values [node][energy]
+  size_t nEval;                ///< Number of function calls
+
+  size_t splitAxes(const size_t) const;
+  size_t split(const size_t);
+  void evaluate(const std::vector<size_t>&,const size_t,const FTYPE&);
+  bool needsRefine(const size_t) const;
+  
+ public:
+
+  WWGOctree(const size_t,const size_t,const double);
+  WWGOctree(const WWGOctree&);
+  WWGOctree& operator=(const WWGOctree&);
+  ~WWGOctree() {}      ///< Destructor
+
+  /// Number of nodes
+  size_t getNNode() const { return Nodes.size(); }
+  /// Number of function calls [traces]
+  size_t getNEval() const { return nEval; }
+  size_t getNLeaf() const;
+
+  void setAxisDepth(const std::array<size_t,3>&);
+  
+  void build(const Geometry::Vec3D&,const Geometry::Vec3D&,
+	     const size_t,const size_t,const FTYPE&);
+
+  size_t findLeaf(const Geometry::Vec3D&) const;
+  const double* getValue(const Geometry::Vec3D&) const;
+
+  void resample(WWGWeight&,const std::vector<size_t>&) const;
+  
+};
+
+}
+
+#endif
@@ -27,6 +27,8 @@ class Simulation;
 namespace WeightSystem
 {
 
+  struct trackPath;
+  
 /*!
   \class WWGWeight
   \version 1.0
@@ -55,6 +57,14 @@ class WWGWeight
   multiData<double> WGrid; 
 
   void resize();
+
+  template<typename T>
+  void tracePath(const Simulation&,const T&,
+		 const Geometry::Vec3D&,trackPath&) const;
+  std::vector<double> pathWeight(const trackPath&,
+				 const std::vector<double>&,
+				 const double,const double,
+				 const double) const;
   
  public:
 
@@ -133,10 +143,20 @@ class WWGWeight
 		   const Geometry::Vec3D&,
 		   const double,const double,
 		   const double) const;
+  template<typename T>
+  std::vector<double> distTrack(const Simulation&,const T&,
+				const std::vector<double>&,
+				const Geometry::Vec3D&,
+				const double,const double,
+				const double) const;
 
   template<typename T>
   void wTrack(const Simulation&,const T&,const size_t,
 	      const double,const double,const double);
+  template<typename T>
+  void octreeTrack(const Simulation&,const T&,const size_t,
+		   const double,const double,const double,
+		   const double,const size_t,const size_t);
 
   template<typename T,typename U>
   void CADISnorm(const Simulation&,const size_t,
@@ -149,9 +169,11 @@ class WWGWeight
 
   void writeGrid(std::ostream&) const;
   void writeWWINP(std::ostream&) const;
+  void writeWWINPBinary(std::ostream&) const;
   void writePHITS(std::ostream&) const;
   void writeFLUKA(std::ostream&) const;
   void writeVTK(std::ostream&,const size_t,const bool =0) const;
+  void writeVTI(std::ostream&,const size_t,const bool =0) const;
   void write(std::ostream&) const;
 };
 
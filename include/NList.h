@@ -75,6 +75,7 @@ class NList
 
   void splitComp();
   int changeItem(const Unit&,const Unit&);
+  size_t changeItem(const std::map<Unit,Unit>&);
   
   int processString(const std::string&);  
   std::vector<Unit> actualItems() const;  
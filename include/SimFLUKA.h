@@ -101,6 +101,7 @@ class SimFLUKA : public Simulation
   void writePhysics(std::ostream&) const;
   void writeSource(std::ostream&) const;
   void writeVariables(std::ostream&) const;
+  void writeCommon(std::ostream&) const;
 
   void clearTally();
 
@@ -158,6 +159,8 @@ class SimFLUKA : public Simulation
   void setForCinder();
 
   void write(const std::string&) const override;
+  void writeMulti(const std::vector<std::string>&,
+		  const std::vector<long int>&);
 
 };
 
@@ -97,6 +97,7 @@ class SimMCNP : public Simulation
   void writeSource(std::ostream&) const;
   void writePhysics(std::ostream&) const;
   void writeImportance(std::ostream&) const;
+  void writeCommon(std::ostream&) const;
 
 
   // The Cinder Write stuff
@@ -137,6 +138,7 @@ class SimMCNP : public Simulation
   
   void setMCNPversion(const int);
   void substituteAllSurface(const int,const int) override;
+  void substituteAllSurface(const std::map<int,int>&) override;
   std::map<int,int> renumberCells(const std::vector<int>&,
 					  const std::vector<int>&) override;
 
@@ -146,6 +148,8 @@ class SimMCNP : public Simulation
   void writeCinder() const override;          
 
   void write(const std::string&) const override;  
+  void writeMulti(const std::vector<std::string>&,
+		  const std::vector<long int>&);
     
 };
 
@@ -77,6 +77,8 @@ class SimPHITS : public Simulation
   void writeTally(std::ostream&) const;
   void writePhysics(std::ostream&) const;
   void writeVariables(std::ostream&) const;
+  void writeHead(std::ostream&) const;
+  void writeTail(std::ostream&) const;
   
  public:
   
@@ -112,6 +114,8 @@ class SimPHITS : public Simulation
   const std::string&  getFileName() const { return fileName; }
   
   void write(const std::string&) const override;
+  void writeMulti(const std::vector<std::string>&,
+		  const std::vector<std::string>&);
 
 };
 
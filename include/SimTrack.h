@@ -43,6 +43,9 @@ namespace ModelSupport
   In a given simulation tracks or isValid operations based on points
   typically start from the last used cell : This keeps a track of the 
   last used cell as an optimization point.
+  The instance is per-thread : Simulations are registered by addSim
+  in the main thread and worker threads add their entry on first use.
+  Unregistered simulations throw in all threads.
 */
 
 
@@ -126,6 +126,7 @@ class SimValid
 		      const Geometry::Vec3D&,
 		      const Geometry::Vec3D&, 
 		      MonteCarlo::Object*);
+  static Geometry::Vec3D randomDir(const unsigned long int,const size_t);
 		 
   
  public:
@@ -43,6 +43,7 @@ namespace Surface
 namespace ModelSupport
 {
   class ObjSurfMap;
+  class CellBVH;
 }
 
 namespace MonteCarlo
@@ -80,11 +81,13 @@ class Simulation : public objectGroups
   
   FuncDataBase DB;                      ///< DataBase of variables
   ModelSupport::ObjSurfMap* OSMPtr;     ///< Object surface map [if required]
+  ModelSupport::CellBVH* BVHPtr;        ///< Cell box tree [if built]
 
   TransTYPE TList;                      ///< Transforms List (key=Transform)
 
   size_t cellDNF;                       ///< max size to convert into DNF
   size_t cellCNF;                       ///< max size to convert into CNF
+  size_t nThreads;                      ///< Threads for cell work [0:all]
   OTYPE OList;                          ///< List of objects  (allow to become hulls)
   std::vector<int> cellOutOrder;        ///< List of cells [output order]
 
@@ -98,6 +101,7 @@ class Simulation : public objectGroups
   int checkInsert(const MonteCarlo::Object&);       ///< Inserts (and test) new hull into Olist map 
   int removeNullSurfaces();
   int removeComplement(MonteCarlo::Object&) const;
+  int calcMinimize(const MonteCarlo::Object*,HeadRule&) const;
   void addObjSurfMap(MonteCarlo::Object*);
 
   std::map<int,int> calcCellRenumber(const std::vector<int>&,
@@ -121,6 +125,10 @@ class Simulation : public objectGroups
   void setCellDNF(const size_t C) { cellDNF=C; }
   /// set cell CNF
   void setCellCNF(const size_t C) { cellCNF=C; }
+  /// set threads for cell processing
+  void setThreads(const size_t N) { nThreads=N; }
+  /// get threads for cell processing
+  size_t getThreads() const { return nThreads; }
 
   void setImp(const int,const double);
   void setImp(const int,const std::string&,const double);
@@ -207,7 +215,10 @@ class Simulation : public objectGroups
   void updateSurface(const int,const std::string&);
 
   void createObjSurfMap();
+  void updateCellBVH();
   void validateObjSurfMap();
+  /// Access cell box tree
+  const ModelSupport::CellBVH& getCellBVH() const { return *BVHPtr; }
   /// Access surface map
   const ModelSupport::ObjSurfMap* getOSM() const;
 
@@ -225,6 +236,7 @@ class Simulation : public objectGroups
   virtual void prepareWrite();  
 
   virtual void substituteAllSurface(const int,const int);
+  virtual void substituteAllSurface(const std::map<int,int>&);
   virtual std::map<int,int> renumberCells(const std::vector<int>&,
 					  const std::vector<int>&);
   
@@ -390,6 +390,32 @@ NList<Unit>::changeItem(const Unit& oldI,const Unit& newI)
   return 0;
 }
 
+template<typename Unit>
+size_t
+NList<Unit>::changeItem(const std::map<Unit,Unit>& RMap)
+  /*!
+    Change all actual Items in a single pass
+    \param RMap :: Map of old value : new value
+    eturn number of items changed
+  */
+{
+  size_t cnt(0);
+  for(CompUnit& CU : Items)
+    {
+      if (CU.first==0)
+	{
+	  typename std::map<Unit,Unit>::const_iterator mc=
+	    RMap.find(CU.second);
+	  if (mc!=RMap.end())
+	    {
+	      CU.second=mc->second;
+	      cnt++;
+	    }
+	}
+    }
+  return cnt;
+}
+
 template<typename Unit>
 void
 NList<Unit>::write(std::ostream& OX) const
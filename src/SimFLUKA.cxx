@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex>
 #include <vector>
@@ -764,16 +765,15 @@ SimFLUKA::prepareWrite()
 }
 
 void
-SimFLUKA::write(const std::string& Fname) const
+SimFLUKA::writeCommon(std::ostream& OX) const
   /*!
-    Write out all the system (in FLUKA output format)
-    \param Fname :: Output file
+    Write out all the blocks that do not depend on the
+    random number seed [everything before the physics]
+    \param OX :: Output stream
   */
 {
-  ELog::RegMethod RegA("SimFLUKA","write");
+  ELog::RegMethod RegA("SimFLUKA","writeCommon");
 
-
-  std::ofstream OX(Fname.c_str());
   const size_t nCells(OList.size());
   const size_t maxCells(20000);
   if (nCells>maxCells)
@@ -823,9 +823,58 @@ SimFLUKA::write(const std::string& Fname) const
       RadDecayPtr->write(*this,OX);
       writeTally(OX);
       writeSource(OX);
-      writePhysics(OX);
     }
+  return;
+}
+
+void
+SimFLUKA::write(const std::string& Fname) const
+  /*!
+    Write out all the system (in FLUKA output format)
+    \param Fname :: Output file
+  */
+{
+  ELog::RegMethod RegA("SimFLUKA","write");
+
+  std::ofstream OX(Fname.c_str());
+  writeCommon(OX);
+  if (!PGeomPtr)
+    writePhysics(OX);
   OX<<"STOP"<<std::endl;
   OX.close();
   return;
 }
+
+void
+SimFLUKA::writeMulti(const std::vector<std::string>& FNames,
+		     const std::vector<long int>& RNDseed)
+  /*!
+    Write out a set of decks that only differ in the random
+    number seed. The common blocks are written to memory once
+    and copied to each file before its physics block.
+    \param FNames :: Output files
+    \param RNDseed :: Random number seed for each file
+  */
+{
+  ELog::RegMethod RegA("SimFLUKA","writeMulti");
+
+  if (FNames.size()!=RNDseed.size())
+    throw ColErr::MisMatch<size_t>(FNames.size(),RNDseed.size(),
+				   "FNames/RNDseed");
+
+  std::ostringstream cx;
+  writeCommon(cx);
+  const std::string commonBlock(cx.str());
+
+  for(size_t i=0;i<FNames.size();i++)
+    {
+      rndSeed=RNDseed[i];
+      std::ofstream OX(FNames[i].c_str());
+      OX<<commonBlock;
+      if (!PGeomPtr)
+	writePhysics(OX);
+      OX<<"STOP"<<std::endl;
+      OX.close();
+    }
+  return;
+}
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex> 
 #include <vector>
@@ -36,6 +37,7 @@
 #include <memory>
 #include <array>
 
+#include "Exception.h"
 #include "FileReport.h"
 #include "NameStack.h"
 #include "RegMethod.h"
@@ -317,6 +319,24 @@ SimMCNP::substituteAllSurface(const int oldSurfN,const int newSurfN)
   return;
 }
 
+void
+SimMCNP::substituteAllSurface(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in the map in the simulation
+    and the tallies
+    \param RMap :: Map of oldSurfN : newSurfN
+  */
+{
+  ELog::RegMethod RegA("SimMCNP","substituteAllSurface(map)");
+
+  Simulation::substituteAllSurface(RMap);
+
+  for(TallyTYPE::value_type& tc : TItem)
+    tc.second->renumberSurf(RMap);
+  
+  return;
+}
+
 				 
 std::map<int,int>
 SimMCNP::renumberCells(const std::vector<int>& cOffset,
@@ -723,14 +743,13 @@ SimMCNP::writeCinderMat() const
 }
 
 void
-SimMCNP::write(const std::string& Fname) const
+SimMCNP::writeCommon(std::ostream& OX) const
   /*!
-    Write out all the system (in MCNPX output format)
-    \param Fname :: Output file 
+    Write out all the blocks that do not depend on the
+    random number seed [everything before the physics]
+    \param OX :: Output stream
   */
 {
-  std::ofstream OX(Fname.c_str());
-  
   OX<<"Input File:"<<inputFile<<std::endl;
   StrFunc::writeMCNPXcomment("RunCmd:"+cmdLine,OX);
   writeVariables(OX);
@@ -742,7 +761,52 @@ SimMCNP::write(const std::string& Fname) const
   writeTally(OX);
   writeSource(OX);
   writeImportance(OX);
+  return;
+}
+
+void
+SimMCNP::write(const std::string& Fname) const
+  /*!
+    Write out all the system (in MCNPX output format)
+    \param Fname :: Output file 
+  */
+{
+  std::ofstream OX(Fname.c_str());
+  
+  writeCommon(OX);
   writePhysics(OX);
   OX.close();
   return;
 }
+
+void
+SimMCNP::writeMulti(const std::vector<std::string>& FNames,
+		    const std::vector<long int>& RNDseed)
+  /*!
+    Write out a set of decks that only differ in the random
+    number seed. The common blocks are written to memory once
+    and copied to each file before its physics block.
+    \param FNames :: Output files
+    \param RNDseed :: Random number seed for each file
+  */
+{
+  ELog::RegMethod RegA("SimMCNP","writeMulti");
+
+  if (FNames.size()!=RNDseed.size())
+    throw ColErr::MisMatch<size_t>(FNames.size(),RNDseed.size(),
+				   "FNames/RNDseed");
+  
+  std::ostringstream cx;
+  writeCommon(cx);
+  const std::string commonBlock(cx.str());
+
+  for(size_t i=0;i<FNames.size();i++)
+    {
+      PhysPtr->setRND(RNDseed[i]);
+      std::ofstream OX(FNames[i].c_str());
+      OX<<commonBlock;
+      writePhysics(OX);
+      OX.close();
+    }
+  return;
+}
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 #include <complex>
 #include <vector>
@@ -526,13 +527,13 @@ SimPHITS::writeImportance(std::ostream& OX) const
 }
 
 void
-SimPHITS::write(const std::string& Fname) const
+SimPHITS::writeHead(std::ostream& OX) const
   /*!
-    Write out all the system (in PHITS output format)
-    \param Fname :: Output file
+    Write out the blocks before the tallies. These do
+    not depend on the output file name.
+    \param OX :: Output stream
   */
 {
-  std::ofstream OX(Fname.c_str());
   OX<<"[Title]"<<std::endl;
   writePhysics(OX);
   //  Simulation::writeVariables(OX);
@@ -543,12 +544,71 @@ SimPHITS::write(const std::string& Fname) const
   writeMaterial(OX);
   writeWeights(OX);
   writeTransform(OX);
-  writeTally(OX);
+  return;
+}
+
+void
+SimPHITS::writeTail(std::ostream& OX) const
+  /*!
+    Write out the blocks after the tallies
+    \param OX :: Output stream
+  */
+{
   writeSource(OX);
   writeImportance(OX);
   writeMagnet(OX);
 
   OX<<"[end]"<<std::endl;
+  return;
+}
+
+void
+SimPHITS::write(const std::string& Fname) const
+  /*!
+    Write out all the system (in PHITS output format)
+    \param Fname :: Output file
+  */
+{
+  std::ofstream OX(Fname.c_str());
+  writeHead(OX);
+  writeTally(OX);
+  writeTail(OX);
   OX.close();
   return;
 }
+
+void
+SimPHITS::writeMulti(const std::vector<std::string>& FNames,
+		     const std::vector<std::string>& TNames)
+  /*!
+    Write out a set of decks that only differ in the tally
+    output file name. The blocks before and after the tallies
+    are written to memory once and copied to each file.
+    \param FNames :: Output files
+    \param TNames :: Tally file name for each output file
+  */
+{
+  ELog::RegMethod RegA("SimPHITS","writeMulti");
+
+  if (FNames.size()!=TNames.size())
+    throw ColErr::MisMatch<size_t>(FNames.size(),TNames.size(),
+				   "FNames/TNames");
+
+  std::ostringstream cx;
+  writeHead(cx);
+  const std::string headBlock(cx.str());
+  cx.str("");
+  writeTail(cx);
+  const std::string tailBlock(cx.str());
+
+  for(size_t i=0;i<FNames.size();i++)
+    {
+      fileName=TNames[i];
+      std::ofstream OX(FNames[i].c_str());
+      OX<<headBlock;
+      writeTally(OX);
+      OX<<tailBlock;
+      OX.close();
+    }
+  return;
+}
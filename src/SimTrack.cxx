@@ -42,6 +42,18 @@
 namespace ModelSupport
 {
 
+static std::set<unsigned long int>&
+simRegister()
+  /*!
+    Simulations registered by addSim [all threads]. Only
+    the main thread adds/removes so worker threads only read
+    \return registered simulation keys
+  */
+{
+  static std::set<unsigned long int> SR;
+  return SR;
+}
+  
 SimTrack::SimTrack() 
   /*!
     Constructor
@@ -51,11 +63,12 @@ SimTrack::SimTrack()
 SimTrack&
 SimTrack::Instance()
   /*!
-    Singleton this
+    Singleton this : one per thread so that tracking
+    threads do not share the last-cell cache
     \return SimTrack object
    */
 {
-  static SimTrack ST;
+  static thread_local SimTrack ST;
   return ST;
 }
 
@@ -66,10 +79,12 @@ SimTrack::clearSim(const Simulation* SimPtr)
     \param SimPtr :: Simulation pointer
   */
 {
-  fcTYPE::iterator mc=findCell.
-    find(reinterpret_cast<fcTYPE::key_type>(SimPtr));
+  const fcTYPE::key_type sInt=
+    reinterpret_cast<fcTYPE::key_type>(SimPtr);
+  fcTYPE::iterator mc=findCell.find(sInt);
   if (mc!=findCell.end())
     findCell.erase(mc);
+  simRegister().erase(sInt);
   return;
 }
 
@@ -86,6 +101,7 @@ SimTrack::addSim(const Simulation* SimPtr)
   fcTYPE::iterator mc=findCell.find(sInt);
   if (mc==findCell.end())
     findCell.insert(fcTYPE::value_type(sInt,0));
+  simRegister().insert(sInt);
   return;
 }
 
@@ -99,12 +115,16 @@ SimTrack::setCell(const Simulation* SimPtr,MonteCarlo::Object* OPtr)
 {
   ELog::RegMethod RegA("SimTrack","setCell");
 
+  // Simulations are only added in the main thread: a worker
+  // thread gains its entry on first use if registered
   fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
   fcTYPE::iterator mc=findCell.find(sInt);
   if (mc==findCell.end())
     {
-      throw ColErr::InContainerError<fcTYPE::key_type>
-	(sInt,"sInt not fould in findCell");
+      if (!simRegister().contains(sInt))
+	throw ColErr::InContainerError<fcTYPE::key_type>
+	  (sInt,"sInt not fould in findCell");
+      mc=findCell.emplace(sInt,nullptr).first;
     }
   mc->second=OPtr;
   return;
@@ -114,18 +134,20 @@ MonteCarlo::Object*
 SimTrack::curCell(const Simulation* SimPtr) const
   /*!
     Get the current cell
-    \param SimPtr :: Significant figures
-    \return :: Object Pointer
+    \param SimPtr :: Simulation 
+    \return :: Object Pointer [0 if not set in this thread]
   */
 {
   ELog::RegMethod RegA("SimTrack","curCell");
 
   fcTYPE::key_type sInt=reinterpret_cast<fcTYPE::key_type>(SimPtr);
   fcTYPE::const_iterator mc=findCell.find(sInt);
-  if (mc==findCell.end())
+  if (mc!=findCell.end())
+    return mc->second;
+  if (!simRegister().contains(sInt))
     throw ColErr::InContainerError<fcTYPE::key_type>
       (sInt,"simluation<long Int>");
-  return mc->second;
+  return 0;
 }
 
 void
@@ -34,6 +34,7 @@
 #include <algorithm>
 #include <iterator>
 #include <random>
+#include <functional>
 
 #include "FileReport.h"
 #include "NameStack.h"
@@ -47,6 +48,7 @@
 #include "MapSupport.h"
 #include "Code.h"
 #include "FuncDataBase.h"
+#include "RuleEval.h"
 #include "HeadRule.h"
 #include "Importance.h"
 #include "Object.h"
@@ -66,6 +68,8 @@
 #include "groupRange.h"
 #include "objectGroups.h"
 #include "Simulation.h"
+#include "SimTrack.h"
+#include "threadSupport.h"
 
 #include "SimValid.h"
 
@@ -168,7 +172,8 @@ SimValid::checkPoint(const Geometry::Vec3D& TP,
       std::set<const MonteCarlo::Object*> foundSet;
       for(const MonteCarlo::Object* TOPtr : checkObj)
 	{
-	  if (TOPtr->isValid(TP,surfState))
+	  if (TOPtr->inBoundBox(TP) &&
+	      TOPtr->isValid(TP,surfState))
 	    foundSet.emplace(TOPtr);
 	}
       
@@ -304,19 +309,43 @@ SimValid::runUnit(const Simulation& System,
 		  MonteCarlo::Object* initObj) 
   /*!
     Runs a single unit:
+    Track state is local so this can be called from any thread.
     \param System :: Simulation
     \param initPos :: Inital position
+    \param axis :: Direction of track
+    \param initObj :: Initial object
+    \return true if the track was completed
    */
 {
-  static ModelSupport::LineTrack LT(initPos,axis,1e38);
-
-  LT.setPts(initPos,axis);
-  LT.clearAll();
+  ModelSupport::LineTrack LT(initPos,axis,1e38);
   //  const ModelSupport::ObjSurfMap* OSMPtr =System.getOSM();
 
   return (LT.calculate(System,initObj)) ? 0 : 1;
 } 
 
+Geometry::Vec3D
+SimValid::randomDir(const unsigned long int baseSeed,
+		    const size_t index)
+  /*!
+    Random direction for track index. Each track has its own
+    generator so the direction does not depend on the
+    order/thread that tracks are run in.
+    \param baseSeed :: Seed for this run point
+    \param index :: Track index
+    \return unit vector
+   */
+{
+  std::seed_seq SSeq{baseSeed,static_cast<unsigned long int>(index)};
+  std::mt19937 gen(SSeq);
+  std::uniform_real_distribution<double> RNG(0.0,1.0);
+  
+  const double phi=RNG(gen)*M_PI;
+  const double theta=2.0*RNG(gen)*M_PI;
+  return Geometry::Vec3D(cos(theta)*sin(phi),
+			 sin(theta)*sin(phi),
+			 cos(phi));
+}
+
 void
 SimValid::diagnostics(const Simulation& System,
 		     const std::vector<simPoint>& Pts) const
@@ -402,10 +431,6 @@ SimValid::runPoint(const Simulation& System,
   std::set<Geometry::Vec3D> MultiPoint;
   MonteCarlo::Object* InitObj(0);
 
-  // Note for sphere that you can use X,Y,Z in any orthogonal 
-  // directiron
-  double phi,theta;
-
   // Find Initial cell [Store for next time]
   //  Centre+=Geometry::Vec3D(0.001,0.001,0.001);
   int initSurfNum(0);
@@ -424,31 +449,51 @@ SimValid::runPoint(const Simulation& System,
     }
   while(initSurfNum);
       
-  // check surfaces
+  // Directions are run in blocks over the threads : the first
+  // failed track [lowest index] in a block is reported
+  const size_t NBlock(4096);
+  const unsigned long int baseSeed=
+    static_cast<unsigned long int>(Random::rand()*4294967295.0);
+
   ELog::EM<<"NAngle == "<<nAngle<<" :: "<<CP<<ELog::endDiag;
-  for(size_t i=0;i<nAngle;i++)
+  std::vector<char> trackFail;
+  for(size_t blockStart=0;blockStart<nAngle;blockStart+=NBlock)
     {
-      if (nAngle>10000 && i*10==nAngle)
-	ELog::EM<<"ValidPoint Angle[ == "<<i<<"]"<<ELog::endDiag;
-      std::vector<simPoint> Pts;
-      // Get random starting point on edge of volume
-      phi=Random::rand()*M_PI;
-      theta=2.0*Random::rand()*M_PI;
-      Geometry::Vec3D uVec(cos(theta)*sin(phi),
-			     sin(theta)*sin(phi),
-			     cos(phi));
-
-      MonteCarlo::eTrack THold(Pt,uVec);
-      MonteCarlo::Object* OPtr=InitObj;
-      int SN(-initSurfNum);
-
-      Pts.push_back(simPoint(Pt,uVec,OPtr->getName(),SN,OPtr));
-
-      bool outFlag=runUnit(System,Pt,uVec,InitObj);
-      if (!outFlag)
+      const size_t NB=std::min(NBlock,nAngle-blockStart);
+      if (nAngle>10000 && blockStart<=nAngle/10 &&
+	  nAngle/10<blockStart+NB)
+	ELog::EM<<"ValidPoint Angle[ == "<<nAngle/10<<"]"<<ELog::endDiag;
+
+      trackFail.assign(NB,0);
+      threadSupport::parallelLoop
+	(System.getThreads(),NB,
+	 [&](const size_t index)
+	 {
+	   ModelSupport::SimTrack::Instance().setCell(&System,0);
+	   const Geometry::Vec3D uVec=
+	     randomDir(baseSeed,blockStart+index);
+	   if (!runUnit(System,Pt,uVec,InitObj))
+	     trackFail[index]=1;
+	 });
+
+      const std::vector<char>::const_iterator vc=
+	std::find(trackFail.begin(),trackFail.end(),1);
+      if (vc!=trackFail.end())
 	{
+	  const size_t i=blockStart+
+	    static_cast<size_t>(vc-trackFail.begin());
+	  const size_t nFail=static_cast<size_t>
+	    (std::count(trackFail.begin(),trackFail.end(),1));
+	  const Geometry::Vec3D uVec=randomDir(baseSeed,i);
+	  MonteCarlo::eTrack THold(Pt,uVec);
+	  std::vector<simPoint> Pts;
+	  Pts.push_back(simPoint(Pt,uVec,InitObj->getName(),
+				 -initSurfNum,InitObj));
+
+	  ModelSupport::SimTrack::Instance().setCell(&System,0);
 	  bool newFlag=runUnit(System,Pt,uVec,InitObj);
 	  ELog::EM<<"NEW FLAG == "<<newFlag<<ELog::endDiag;
+	  ELog::EM<<"Failed tracks in block == "<<nFail<<ELog::endCrit;
 	  ELog::EM<<"OPtr not found["<<i<<"] at : "<<Pt<<ELog::endCrit;
 	  ELog::EM<<"EHOLD:"<<THold<<ELog::endCrit;
 	  ELog::EM<<"EHOLD:"<<CP<<ELog::endCrit;
@@ -456,18 +501,15 @@ SimValid::runPoint(const Simulation& System,
 	  for(const simPoint& SP : Pts)
 	    ELog::EM<<"Pt == "<<SP<<ELog::endDiag;
 	  ModelSupport::LineTrack LT(Pt,uVec,10000.0);
-	  LT.calculate(System);
+	  if (LT.calculate(System))
+	    ELog::EM<<"INIT POINT[error] == "<<Pt<<ELog::endCrit;
 	  ELog::EM<<"LT == "<<LT<<ELog::endDiag;
 	  ELog::EM<<"END Line SEARCH == "<<ELog::endCrit;
 	  
-	  if (!InitObj)
-	    ELog::EM<<"Failed to calculate INITIAL cell correctly: "<<ELog::endCrit;
-	  else
-	    ELog::EM<<"Initial Cell ="<<*InitObj<<ELog::endDiag;
+	  ELog::EM<<"Initial Cell ="<<*InitObj<<ELog::endDiag;
 	  //	  diagnostics(System,Pts);
 	  return 0;
 	}
-
     }
   return 1;
 }
@@ -545,30 +587,42 @@ SimValid::checkPoint(const Simulation& System,
 			      BSurf.begin(),BSurf.end(),
 			      std::inserter(commonSurf,commonSurf.begin()) );
 	int errFlag(1);
-	std::map<int,int> SNeg,SPlus;
-	for(const int SN : commonSurf)
+	const RuleEval* AEval=APtr->getHeadRule().getEval();
+	const RuleEval* BEval=BPtr->getHeadRule().getEval();
+	if (AEval && BEval)
 	  {
-	    SNeg.emplace(SN,-1);
-	    SPlus.emplace(SN,-1);
+	    // any side of the common surfaces that splits A/B
+	    if (!commonSurf.empty() &&
+		RuleEval::isDifferent(*AEval,*BEval,Pt,commonSurf,0))
+	      errFlag=0;
 	  }
-	for(const int SN : commonSurf)
+	else
 	  {
-	    // both reset to -1 state:
-	    for(auto& [sideName,flag] : SNeg) flag=-1;
-	    for(auto& [sideName,flag] : SPlus) flag=-1;
-	    SNeg[SN]=-1;
-	    SPlus[SN]=1;
-	    do
+	    std::map<int,int> SNeg,SPlus;
+	    for(const int SN : commonSurf)
+	      {
+		SNeg.emplace(SN,-1);
+		SPlus.emplace(SN,-1);
+	      }
+	    for(const int SN : commonSurf)
 	      {
-		if ((APtr->isValid(Pt,SNeg) != BPtr->isValid(Pt,SNeg)) ||
-		    (APtr->isValid(Pt,SPlus) != BPtr->isValid(Pt,SPlus)) )
+		// both reset to -1 state:
+		for(auto& [sideName,flag] : SNeg) flag=-1;
+		for(auto& [sideName,flag] : SPlus) flag=-1;
+		SNeg[SN]=-1;
+		SPlus[SN]=1;
+		do
 		  {
-		    errFlag=0;
-		  }
-	      }	 while(errFlag &&
-		       !MapSupport::iterateBinMapLocked(SNeg,SN,-1,1) && 
-		       !MapSupport::iterateBinMapLocked(SPlus,SN,-1,1));
-	    if (!errFlag) break;
+		    if ((APtr->isValid(Pt,SNeg) != BPtr->isValid(Pt,SNeg)) ||
+			(APtr->isValid(Pt,SPlus) != BPtr->isValid(Pt,SPlus)) )
+		      {
+			errFlag=0;
+		      }
+		  } while(errFlag &&
+			  !MapSupport::iterateBinMapLocked(SNeg,SN,-1,1) && 
+			  !MapSupport::iterateBinMapLocked(SPlus,SN,-1,1));
+		if (!errFlag) break;
+	      }
 	  }
 	if (errFlag)
 	  {
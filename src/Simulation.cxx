@@ -34,6 +34,7 @@
 #include <numeric>
 #include <iterator>
 #include <memory>
+#include <atomic>
 #include <array>
 
 #include "Exception.h"
@@ -69,11 +70,14 @@
 #include "HeadRule.h"
 #include "Importance.h"
 #include "Object.h"
+#include "threadSupport.h"
 #include "weightManager.h"
 #include "inputSupport.h"
 #include "SourceBase.h"
 #include "sourceDataBase.h"
 #include "ObjSurfMap.h"
+#include "BBox.h"
+#include "CellBVH.h"
 #include "SimTrack.h"
 #include "surfRegister.h"
 #include "HeadRule.h"
@@ -87,7 +91,8 @@
 
 Simulation::Simulation()  :
   OSMPtr(new ModelSupport::ObjSurfMap),
-  cellDNF(0),cellCNF(0)
+  BVHPtr(new ModelSupport::CellBVH),
+  cellDNF(0),cellCNF(0),nThreads(1)
   /*!
     Start of simulation Object
   */
@@ -103,7 +108,9 @@ Simulation::Simulation(const Simulation& A) :
   inputFile(A.inputFile),
   cmdLine(A.cmdLine),DB(A.DB),
   OSMPtr(new ModelSupport::ObjSurfMap(*A.OSMPtr)),
+  BVHPtr(new ModelSupport::CellBVH),
   TList(A.TList),cellDNF(A.cellDNF),cellCNF(A.cellCNF),
+  nThreads(A.nThreads),
   cellOutOrder(A.cellOutOrder),
   sourceName(A.sourceName)
   /*!
@@ -131,6 +138,7 @@ Simulation::operator=(const Simulation& A)
       TList=A.TList;
       cellDNF=A.cellDNF;
       cellCNF=A.cellCNF;
+      nThreads=A.nThreads;
       OList=A.OList;
       cellOutOrder=A.cellOutOrder;
       sourceName=A.sourceName;
@@ -149,6 +157,7 @@ Simulation::~Simulation()
 
   delete OSMPtr;
   deleteObjects();
+  delete BVHPtr;
   ModelSupport::SimTrack::Instance().clearSim(this);
 
 }
@@ -187,6 +196,7 @@ Simulation::deleteObjects()
   ELog::RegMethod RegA("Simulation","deleteObjects");
 
   ModelSupport::SimTrack::Instance().setCell(this,0);
+  BVHPtr->clearAll();
   for(OTYPE::value_type& mc : OList)
     delete mc.second;
 
@@ -215,9 +225,13 @@ Simulation::checkInsert(const MonteCarlo::Object& A)
     {
       ELog::EM<<"Over-writing Object ::"<<cellNumber<<ELog::endWarn;
       (*mpt->second)=A;
+      BVHPtr->removeObject(mpt->second);
+      BVHPtr->addObject(mpt->second);
       return 0;
     }
-  OList.insert(OTYPE::value_type(cellNumber,A.clone()));
+  MonteCarlo::Object* QPtr=A.clone();
+  OList.insert(OTYPE::value_type(cellNumber,QPtr));
+  BVHPtr->addObject(QPtr);
   return 1;
 }
 
@@ -407,6 +421,7 @@ Simulation::removeDeadSurfaces()
   for(const int DSurf : Dead)
     SurI.deleteSurface(DSurf);
 
+  updateCellBVH();
   return 0;
 }
 
@@ -467,6 +482,7 @@ Simulation::removeCell(const int cellNumber)
     throw ColErr::InContainerError<int>(cellNumber,"cellNumber in OList");
 
   OSMPtr->removeObject(vc->second);
+  BVHPtr->removeObject(vc->second);
 
   ModelSupport::SimTrack& ST(ModelSupport::SimTrack::Instance());
   ST.checkDelete(this,vc->second);
@@ -536,6 +552,34 @@ Simulation::substituteAllSurface(const int oldSurfN,const int newSurfN)
   return;
 }
 
+void
+Simulation::substituteAllSurface(const std::map<int,int>& RMap)
+  /*!
+    Renumber all the surfaces in the map in a single pass
+    over the simulation. 
+    \param RMap :: Map of oldSurfN : newSurfN
+  */
+{
+  ELog::RegMethod RegA("Simulation","substituteAllSurface(map)");
+
+  SDef::sourceDataBase& SDB=SDef::sourceDataBase::Instance();
+
+  // SurfaceIndex and surfaces already updated
+  for(const auto& [cellN,objPtr] : OList)
+    objPtr->substituteSurf(RMap);
+  OSMPtr->renumberSurf(RMap);
+
+  // Source:
+  if (!sourceName.empty())
+    {
+      SDef::SourceBase* SPtr=
+	SDB.getSourceThrow<SDef::SourceBase>(sourceName,"Source not known");
+      SPtr->substituteSurface(RMap);
+    }
+
+  return;
+}
+
 std::set<int>
 Simulation::getActiveMaterial() const
 {
@@ -658,9 +702,9 @@ Simulation::removeComplement(MonteCarlo::Object& OB) const
 
   MonteCarlo::Algebra AX;
 
-  AX.setFunctionObjStr(OB.cellStr(OList));
+  AX.setFunctionObj(OB.topRule(),OList);
 
-  return OB.procString(AX.writeMCNPX());
+  return OB.procHeadRule(AX.writeHeadRule());
 }
 
 
@@ -686,10 +730,8 @@ Simulation::removeComplements()
 	  if (workObj.isPopulated())
 	    {
 	      MonteCarlo::Algebra AX;
-	      AX.setFunctionObjStr(workObj.cellStr(OList));
-	      if (!workObj.procString(AX.writeMCNPX()))
-		throw ColErr::InvalidLine(AX.writeMCNPX(),
-					  "Algebra Complement");
+	      AX.setFunctionObj(workObj.topRule(),OList);
+	      workObj.procHeadRule(AX.writeHeadRule());
 
 	      workObj.populate();
 	      workObj.createSurfaceList();
@@ -994,7 +1036,8 @@ Simulation::updateSurface(const int SN,const std::string& SLine)
   if (SurI.getSurf(SN))
     SurI.deleteSurface(SN);
   SurI.createSurface(SN,SLine);
-  //
+  // cell boxes may no longer be valid
+  BVHPtr->clearAll();
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
     {
@@ -1062,6 +1105,23 @@ Simulation::createObjSurfMap()
       // First add surface that are opposite
       OSMPtr->addSurfaces(mc->second);
     }
+  BVHPtr->build(OList);
+  return;
+}
+
+void
+Simulation::updateCellBVH()
+  /*!
+    Rebuild the cell box tree if it has been built but
+    a cell in it has since changed. This also fills
+    the cell bounding boxes [serially] so they are only
+    read by later tracking threads.
+  */
+{
+  ELog::RegMethod RegA("Simulation","updateCellBVH");
+
+  if (BVHPtr->isStale())
+    BVHPtr->build(OList);
   return;
 }
 
@@ -1297,6 +1357,15 @@ Simulation::findCell(const Geometry::Vec3D& Pt,
       && curObjPtr->isValid(Pt))
     return curObjPtr;
 
+  // test only cells whose box contains Pt : the boxes
+  // are conservative so a miss is no cell
+  if (BVHPtr->isBuilt())
+    {
+      MonteCarlo::Object* OPtr=
+	BVHPtr->findCell(Pt,testCell,curObjPtr);
+      ST.setCell(this,OPtr);
+      return OPtr;
+    }
   // now we need to search everthing
   OTYPE::const_iterator mpc;
   for(mpc=OList.begin();mpc!=OList.end();mpc++)
@@ -1615,13 +1684,14 @@ Simulation::renumberSurfaces(const std::vector<int>& rLow,
 
   if (SI.calcRenumber(rLow,rHigh,10000,ChangeList))
     {
-      std::vector< std::pair<int,int> >::const_iterator dc;
-      for(dc=ChangeList.begin();dc!=ChangeList.end();dc++)
+      std::map<int,int> RMap;
+      for(const auto& [oldSurfN,newSurfN] : ChangeList)
 	{
-	  ELog::RN<<"Surf Change:"<<dc->first<<" "<<dc->second<<ELog::endDiag;
-	  SI.renumber(dc->first,dc->second);
-	  substituteAllSurface(dc->first,dc->second);
+	  ELog::RN<<"Surf Change:"<<oldSurfN<<" "<<newSurfN<<ELog::endDiag;
+	  RMap.emplace(oldSurfN,newSurfN);
 	}
+      SI.renumber(RMap);
+      substituteAllSurface(RMap);
     }
   return;
 }
@@ -1728,39 +1798,78 @@ Simulation::splitObject(const int CA,const int newCN,const int SN)
 int
 Simulation::minimizeObject(const std::string& keyName)
   /*!
-    Minimize and remove those objects that are not needed
+    Minimize and remove those objects that are not needed.
+    The algebra for each cell is independent so it is
+    carried out over nThreads, the results are then applied
+    in cell order so the output does not depend on the
+    thread count. A built cell tree is rebuilt for the
+    changed cells.
     \param keyName :: range of object in group
     \return true if an object changed/removed
   */
 {
   ELog::RegMethod RegA("Simulation","minimizeObject(keyname)");
 
-  int retFlag(0);
-  const std::set<int> cVec=objectGroups::getObjectRange(keyName);
+  const std::set<int> cSet=objectGroups::getObjectRange(keyName);
+  const std::vector<int> cVec(cSet.begin(),cSet.end());
+
+  std::vector<MonteCarlo::Object*> OVec;
   for(const int CN : cVec)
     {
-      if (minimizeObject(CN))
-	retFlag=1;
+      MonteCarlo::Object* CPtr = findObject(CN);
+      if (!CPtr)
+	throw ColErr::InContainerError<int>(CN,"Cell not found");
+      CPtr->populate();
+      CPtr->createSurfaceList();
+      OVec.push_back(CPtr);
+    }
+
+  std::vector<int> flag(OVec.size(),0);
+  std::vector<HeadRule> HRVec(OVec.size());
+  threadSupport::parallelLoop
+    (nThreads,OVec.size(),[&](const size_t i)
+     {
+       flag[i]=calcMinimize(OVec[i],HRVec[i]);
+     });
+
+  int retFlag(0);
+  for(size_t i=0;i<OVec.size();i++)
+    {
+      if (flag[i]>0)
+	{
+	  MonteCarlo::Object* OPtr=OVec[i];
+	  OPtr->procHeadRule(HRVec[i]);
+	  OPtr->populate();
+	  OPtr->createSurfaceList();
+	  OSMPtr->updateObject(OPtr);
+	  retFlag=1;
+	}
+      else if (flag[i]<0)
+	{
+	  Simulation::removeCell(cVec[i]);
+	  retFlag=1;
+	}
     }
+  updateCellBVH();
   return retFlag;
 }
 
 int
-Simulation::minimizeObject(MonteCarlo::Object* OPtr)
-  /*
-    Carry out minimization of a cell to remove
-    literals which can be removed due to implicates [e.g. a->b etc]
-    due to parallel surfaces
-    \param CN :: Cell to minimize
+Simulation::calcMinimize(const MonteCarlo::Object* OPtr,
+			 HeadRule& HR) const
+  /*!
+    Calculate the minimized form of a cell. The cell must
+    be populated and its surface list built. Does not
+    change the object so can be called concurrently on
+    different cells.
+    \param OPtr :: Cell to minimize
+    \param HR :: Minimized rule [if changed]
     \retval 1 :: if an object changed
     \retval 0 :: if an object unchanged
-    \retval -1 :: if an object deleted
+    \retval -1 :: if an object is empty
   */
 {
-  ELog::RegMethod RegA("Simulation","minimizeObject(Object)");
-
-  OPtr->populate();
-  OPtr->createSurfaceList();
+  ELog::RegMethod RegA("Simulation","calcMinimize");
 
   std::vector<std::pair<int,int>>
     IP=OPtr->getImplicatePairs();
@@ -1770,7 +1879,7 @@ Simulation::minimizeObject(MonteCarlo::Object* OPtr)
 
   bool activeFlag(0);
   MonteCarlo::Algebra AX;
-  AX.setFunctionObjStr(OPtr->cellCompStr());
+  AX.setFunctionObj(OPtr->topRule(),OList);
   AX.addImplicates(IP);
 
   for(const int SN : SPair)
@@ -1778,23 +1887,42 @@ Simulation::minimizeObject(MonteCarlo::Object* OPtr)
 
   activeFlag |= AX.constructShannonExpansion();
 
-  if (activeFlag)
-    {
-      if (AX.isEmpty())
-	return -1;
+  if (!activeFlag)
+    return 0;
+  if (AX.isEmpty())
+    return -1;
+
+  HR=AX.writeHeadRule();
+  return 1;
+}
+
+int
+Simulation::minimizeObject(MonteCarlo::Object* OPtr)
+  /*
+    Carry out minimization of a cell to remove
+    literals which can be removed due to implicates [e.g. a->b etc]
+    due to parallel surfaces
+    \param CN :: Cell to minimize
+    \retval 1 :: if an object changed
+    \retval 0 :: if an object unchanged
+    \retval -1 :: if an object deleted
+  */
+{
+  ELog::RegMethod RegA("Simulation","minimizeObject(Object)");
 
-      if (!OPtr->procString(AX.writeMCNPX()))
-	throw ColErr::InvalidLine(AX.writeMCNPX(),
-				  "Algebra Export");
+  OPtr->populate();
+  OPtr->createSurfaceList();
 
+  HeadRule HR;
+  const int flag=calcMinimize(OPtr,HR);
+  if (flag>0)
+    {
+      OPtr->procHeadRule(HR);
       OPtr->populate();
       OPtr->createSurfaceList();
       OSMPtr->updateObject(OPtr);
-
-      return 1;
     }
-  
-  return 0;
+  return flag;
 }
 
 int
@@ -1824,48 +1952,59 @@ Simulation::minimizeObject(const int CN)
 void
 Simulation::makeObjectsDNForCNF()
    /*!
-     Expand the objects into DNF form or CNF form
+     Expand the objects into DNF form or CNF form.
+     The expansion of each cell is independent so is carried
+     out over nThreads.
    */
 {
   ELog::RegMethod RegA("Simulation","makeObjectsDNForCNF");
 
   if (cellCNF || cellDNF)
     {
-      size_t cellIndex(0);
+      std::vector<MonteCarlo::Object*> OVec;
       for(OTYPE::value_type& OC : OList)
+	OVec.push_back(OC.second);
+
+      std::vector<size_t> NL(OVec.size());
+      std::vector<size_t> NLX(OVec.size());
+      std::vector<HeadRule> HRVec(OVec.size());
+      threadSupport::parallelLoop
+	(nThreads,OVec.size(),[&](const size_t i)
+	 {
+	   MonteCarlo::Algebra AX;
+	   AX.setFunctionObj(OVec[i]->topRule(),OList);
+	   NL[i]=AX.countLiterals();
+	   if (NL[i]<=cellDNF || NL[i]<=cellCNF)
+	     {
+	       // Note both together possible
+	       if (NL[i]<=cellDNF)
+		 AX.expandBracket();
+	       if (NL[i]<=cellCNF)
+		 AX.expandCNFBracket();
+	       HRVec[i]=AX.writeHeadRule();
+	       NLX[i]=AX.countLiterals();
+	     }
+	 });
+
+      size_t cellIndex(0);
+      for(size_t i=0;i<OVec.size();i++)
 	{
-	  MonteCarlo::Object* CPtr = OC.second;
-	  MonteCarlo::Algebra AX;
-	  AX.setFunctionObjStr(CPtr->cellCompStr());
-	  const size_t NL=AX.countLiterals();
-	  if (NL<=cellDNF || NL<=cellCNF)
+	  MonteCarlo::Object* CPtr = OVec[i];
+	  if (NL[i]<=cellDNF || NL[i]<=cellCNF)
 	    {
-	      // Note both together possible
-	      if (NL<=cellDNF)
-		AX.expandBracket();
-	      if (NL<=cellCNF)
-		AX.expandCNFBracket();
-
-	      if (!CPtr->procString(AX.writeMCNPX()))
+	      CPtr->procHeadRule(HRVec[i]);
+	      if (NLX[i] !=NL[i])
 		{
-		  ELog::EM<<ELog::endDiag;
-		  throw ColErr::InvalidLine(AX.writeMCNPX(),
-					    "Algebra ExpandD/CNFBracket");
-		}
-	      const size_t NLX=AX.countLiterals();
-	      if (NLX !=NL)
-		{
-		  ELog::EM<<CPtr->getName()<<"["<<NL<<","<<NLX<<"] ";
+		  ELog::EM<<CPtr->getName()<<"["<<NL[i]<<","<<NLX[i]<<"] ";
 		  cellIndex++;
 		  if (!(cellIndex % 8)) ELog::EM<<ELog::endDiag;
 		}
-
 	    }
 	  else
 	    {
 	      if (cellIndex % 8) ELog::EM<<ELog::endDiag;
 	      ELog::EM<<"\nNOT Cell "<<CPtr->getName()
-			  <<"["<<NL<<"]"<<ELog::endCrit;
+			  <<"["<<NL[i]<<"]"<<ELog::endCrit;
 	      ELog::EM<<"\n";
 	      cellIndex=0;
 	    }
@@ -1905,17 +2044,22 @@ Simulation::masterRotation()
 
   masterRotate& MR = masterRotate::Instance();
 
-  const ModelSupport::surfIndex::STYPE& SurMap=
-    ModelSupport::surfIndex::Instance().surMap();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  const ModelSupport::surfIndex::STYPE& SurMap=SurI.surMap();
 
   std::map<int,Geometry::Surface*>::const_iterator sc;
   for(sc=SurMap.begin();sc!=SurMap.end();sc++)
     MR.applyFull(sc->second);
+  SurI.resetHash();
+  BVHPtr->clearAll();
 
   // Apply to QHull if calculated:
   OTYPE::iterator oc;
   for(oc=OList.begin();oc!=OList.end();oc++)
-    MR.applyFull(oc->second);
+    {
+      MR.applyFull(oc->second);
+      oc->second->clearBoundBox();
+    }
 
   objectGroups::rotateMaster();
 
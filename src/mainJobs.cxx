@@ -127,8 +127,21 @@ createVTK(const mainSystem::inputParam& IParam,
       const std::string tagName=(fFlag) ? "fem" : "vtk";
       const std::string meshName=(fFlag) ? "femMesh" : "vtkMesh";
 
-      const std::string vForm=
-	IParam.getDefValue<std::string>("",tagName,0);
+      // options : line [average] / binary [vti]
+      bool lineFlag(0);
+      bool binFlag(0);
+      for(size_t i=0;i<IParam.itemCnt(tagName,0);i++)
+	{
+	  const std::string vForm=
+	    IParam.getValue<std::string>(tagName,0,i);
+	  if (vForm=="line")
+	    lineFlag=1;
+	  else if (vForm=="binary" || vForm=="vti")
+	    binFlag=1;
+	}
+      const std::string binName=
+	(OName.size()>4 && OName.substr(OName.size()-4)==".vti") ?
+	OName : OName+".vti";
 
       std::array<size_t,3> MPts;
       Geometry::Vec3D MeshA;
@@ -160,13 +173,16 @@ createVTK(const mainSystem::inputParam& IParam,
       if (fFlag)
 	{
 	  FEM femUnit;
-	  if (vForm=="line")
+	  if (lineFlag)
 	    femUnit.setLineForm(); 
 
 	  femUnit.setBox(MeshA,MeshB);
 	  femUnit.setIndex(MPts[0],MPts[1],MPts[2]);
 	  femUnit.populate(*SimPtr);
-	  femUnit.writeFEM(OName);
+	  if (binFlag)
+	    femUnit.writeVTI(binName);
+	  else
+	    femUnit.writeFEM(OName);
 	}
 
       else
@@ -190,7 +206,7 @@ createVTK(const mainSystem::inputParam& IParam,
 	    throw ColErr::InContainerError<std::string>
 	      (vType,"vtkType unknown");
 	  
-	  if (vForm=="line")
+	  if (lineFlag)
 	    VTK.setLineForm(); 
      
 	  std::set<std::string> Active;
@@ -209,7 +225,10 @@ createVTK(const mainSystem::inputParam& IParam,
 	  if (vFlag)
 	    {
 	      ELog::EM<<"VTK Type == "<<vType<<ELog::endDiag;
-	      if (vType=="cell" || vType=="Cell")
+	      const bool cellFlag(vType=="cell" || vType=="Cell");
+	      if (binFlag)
+		VTK.writeVTI(binName,cellFlag);
+	      else if (cellFlag)
 		VTK.writeIntegerVTK(OName);
 	      else
 		VTK.writeVTK(OName);
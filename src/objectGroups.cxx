@@ -239,7 +239,7 @@ objectGroups::inRangeGroup(const int Index)
 {
   ELog::RegMethod RegA("objectGroups","inRangeGroup");
   
-  static std::string prevName;
+  static thread_local std::string prevName;
 
   // Quick check to determine if it is the same one as before!
   // Note: groupRange could have been updated to can't store
@@ -286,7 +286,7 @@ objectGroups::inRange(const int Index) const
    */
 {
   ELog::RegMethod RegA("objectGroups","inRange");
-  static std::string prevName;
+  static thread_local std::string prevName;
 
   // Quick check to determine if it is the same one as before!
   // Note: groupRange could have been updated to can't store
@@ -37,10 +37,15 @@
 #include "NameStack.h"
 #include "RegMethod.h"
 #include "OutputLog.h" 
+#include "BaseVisit.h"
+#include "BaseModVisit.h"
+#include "Vec3D.h"
 #include "BnId.h"
 #include "AcompTools.h"
 #include "Acomp.h"
 #include "Algebra.h"
+#include "Rules.h"
+#include "HeadRule.h"
 
 #include "Binary.h"
 #include "testFunc.h"
@@ -93,6 +98,7 @@ testAlgebra::applyTest(const int extra)
       &testAlgebra::testMult,
       &testAlgebra::testResolveTrue,
       &testAlgebra::testSetFunction,
+      &testAlgebra::testSetFunctionObj,
       &testAlgebra::testSetFunctionObjStr,
       &testAlgebra::testSubtract,
       &testAlgebra::testWeakDiv
@@ -116,6 +122,7 @@ testAlgebra::applyTest(const int extra)
       "Mult",
       "ResolveTrue",
       "SetFunction",
+      "SetFunctionObj",
       "SetFunctionObjStr",
       "Subtract",
       "WeakDiv"
@@ -976,6 +983,58 @@ testAlgebra::testSetFunctionObjStr()
   return 0;
 }
 
+int
+testAlgebra::testSetFunctionObj()
+  /*!
+    Test the direct conversion from/to a rule tree
+    gives the same as going via the string
+    \return 0 on success
+   */
+{
+  ELog::RegMethod RegA("testAlgebra","testSetFunctionObj");
+
+  const std::vector<std::string> Tests=
+    {
+      "1 -2 3 -4",
+      "(1 : -2 : 3 : -4)",
+      "1 -2 (3 : -4 : (5 6)) 7",
+      "(1 -2) : (3 -4) : 5 : (6 (7 : 8))",
+      "1 -2 #(3 -4 (5 : 6)) #(7 : -8)",
+      "#((1 : 2) -3) : 4",
+      "-31 32 (-33 : 34 : -1 2) 40"
+    };
+
+  for(const std::string& cellStr : Tests)
+    {
+      const HeadRule HR(cellStr);
+
+      Algebra A;
+      Algebra B;
+      A.setFunctionObj(HR.getTopRule());
+      B.setFunctionObjStr(HR.display());
+      if (A.display()!=B.display())
+	{
+	  ELog::EM<<"Input    == "<<cellStr<<ELog::endTrace;
+	  ELog::EM<<"A        == "<<A<<ELog::endTrace;
+	  ELog::EM<<"B[str]   == "<<B<<ELog::endTrace;
+	  return -1;
+	}
+      // back conversion:
+      A.expandBracket();
+      const HeadRule AR=A.writeHeadRule();
+      const HeadRule BR(A.writeMCNPX());
+      if (AR.display()!=BR.display())
+	{
+	  ELog::EM<<"Input    == "<<cellStr<<ELog::endTrace;
+	  ELog::EM<<"A        == "<<A<<ELog::endTrace;
+	  ELog::EM<<"AR       == "<<AR<<ELog::endTrace;
+	  ELog::EM<<"BR[str]  == "<<BR<<ELog::endTrace;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testAlgebra::testSetFunction()
   /*!
@@ -45,7 +45,10 @@
 #include "Vec3D.h"
 #include "interPoint.h"
 #include "support.h"
+#include "mathSupport.h"
+#include "MapSupport.h"
 #include "Rules.h"
+#include "RuleEval.h"
 #include "HeadRule.h"
 #include "surfIndex.h"
 #include "SurInter.h"
@@ -136,6 +139,7 @@ testHeadRule::applyTest(const int extra)
     {
       &testHeadRule::testAddInterUnion,
       &testHeadRule::testCalcSurfIntersection,
+      &testHeadRule::testCompiledEval,
       &testHeadRule::testCountLevel,
       &testHeadRule::testEqual,
       &testHeadRule::testFindNodes,      
@@ -150,6 +154,7 @@ testHeadRule::applyTest(const int extra)
       &testHeadRule::testPartEqual,
       &testHeadRule::testRemoveSurf,
       &testHeadRule::testReplacePart,
+      &testHeadRule::testSubstituteSurf,
       &testHeadRule::testSurfSet,
       &testHeadRule::testSurfValid
     };
@@ -157,6 +162,7 @@ testHeadRule::applyTest(const int extra)
     {
       "AddInterUnion",
       "CalcSurfIntersection",
+      "CompiledEval",
       "CountLevel",
       "Equal",
       "FindNodes",
@@ -171,6 +177,7 @@ testHeadRule::applyTest(const int extra)
       "PartEqual",
       "RemoveSurf",      
       "ReplacePart",      
+      "SubstituteSurf",
       "SurfSet",
       "SurfValid"
     };
@@ -250,6 +257,111 @@ testHeadRule::testAddInterUnion()
   return 0;
 }
 
+int
+testHeadRule::testCompiledEval()
+  /*!
+    Check that the compiled rule gives the same result
+    as the rule tree for points on/off the surfaces
+    \return 0 :: success / -ve on error
+   */
+{
+  ELog::RegMethod RegA("testHeadRule","testCompiledEval");
+
+  createSurfaces();
+
+  const std::vector<std::string> Tests(
+    {
+      "1 -2 3 -4 5 -6",
+      "(1 -2 : 3 -4) 5 -6",
+      "1 -22 23 -24 25 -26 #(1 -2 3 -4 5 -6)",
+      "(1 -2 3) : (-1 -3 5) : -100 -7",
+      "#((-11 : 12) -13) (-1 : -3 : #(-5 6))"
+    });
+
+  const std::vector<double> Grid({-1.5,-1.0,-0.5,0.0,0.5,1.0,1.5});
+  for(const std::string& ruleStr : Tests)
+    {
+      HeadRule A(ruleStr);
+      A.populateSurf();
+      const RuleEval* EPtr=A.getEval();
+      const Rule* TPtr=A.getTopRule();
+      if (!EPtr)
+	{
+	  ELog::EM<<"Rule not compiled "<<A<<ELog::endDiag;
+	  return -1;
+	}
+      // copy / change
+      HeadRule B(A);
+      if (!B.getEval())
+	{
+	  ELog::EM<<"Copy not compiled "<<A<<ELog::endDiag;
+	  return -1;
+	}
+      B.addIntersection(-26);
+      if (B.getEval())
+	{
+	  ELog::EM<<"Changed rule not cleared "<<B<<ELog::endDiag;
+	  return -1;
+	}
+
+      // reference : enumerate the free surfaces on the tree
+      const std::set<const Geometry::Surface*> PSurf=
+	A.getOppositeSurfaces();
+      auto refValid=[&PSurf,TPtr]
+	(const Geometry::Vec3D& Pt,const int S,const int mode) -> bool
+	{
+	  // mode : 0 point / 1 signed surf / 2 either side of surf
+	  std::map<int,int> SMap;
+	  for(const Geometry::Surface* SPtr : PSurf)
+	    if (SPtr->getName()!=S && !SPtr->side(Pt))
+	      SMap.emplace(SPtr->getName(),-1);
+	  if (mode==2)
+	    SMap.emplace(S,-1);
+	  else if (mode==1 && !SMap.empty())
+	    SMap.emplace(std::abs(S),-1);
+	  if (SMap.empty())
+	    return (mode) ? TPtr->isValid(Pt,S) : TPtr->isValid(Pt);
+	  do
+	    {
+	      if ((mode!=1 || SMap[std::abs(S)]==sign(S)) &&
+		  TPtr->isValid(Pt,SMap))
+		return 1;
+	    } while (!MapSupport::iterateBinMap<int>(SMap,-1,1));
+	  return 0;
+	};
+
+      for(const double x : Grid)
+	for(const double y : Grid)
+	  for(const double z : Grid)
+	    {
+	      const Geometry::Vec3D Pt(x,y,z);
+	      const bool flag=EPtr->isValid(Pt);
+	      if (flag!=refValid(Pt,0,0))
+		{
+		  ELog::EM<<"Rule "<<A<<ELog::endDiag;
+		  ELog::EM<<"Eval "<<*EPtr<<ELog::endDiag;
+		  ELog::EM<<"Pt "<<Pt<<" "<<flag<<ELog::endDiag;
+		  return -1;
+		}
+	      for(const int SN : {1,-1,2,-2,3,-3,11,-11})
+		{
+		  const bool flagSN=EPtr->isValid(Pt,SN);
+		  const bool flagSide=EPtr->isSideValid(Pt,std::abs(SN));
+		  if (flagSN!=refValid(Pt,SN,1) ||
+		      flagSide!=refValid(Pt,std::abs(SN),2))
+		    {
+		      ELog::EM<<"Rule "<<A<<ELog::endDiag;
+		      ELog::EM<<"Eval "<<*EPtr<<ELog::endDiag;
+		      ELog::EM<<"Pt "<<Pt<<" SN "<<SN<<" "
+			      <<flagSN<<" "<<flagSide<<ELog::endDiag;
+		      return -1;
+		    }
+		}
+	    }
+    }
+  return 0;
+}
+
 int
 testHeadRule::testCountLevel()
   /*!
@@ -1083,6 +1195,46 @@ testHeadRule::testSurfValid()
   return 0;
 }
 
+int
+testHeadRule::testSubstituteSurf()
+  /*!
+    Check the renumbering of a rule from a map
+    \return 0 :: success / -ve on error
+   */
+{
+  ELog::RegMethod RegA("testHeadRule","testSubstituteSurf");
+
+  createSurfaces();
+
+  typedef std::tuple<std::string,std::map<int,int>,int,std::string> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("1 -2 3 -4",{{1,11},{2,12}},2,"11 -12 3 -4"),
+      TTYPE("1 -2 : 3",{{1,2},{2,1}},2,"2 -1 : 3"),
+      TTYPE("#(1 -2) 3 -3",{{1,11},{3,-13}},3,"#(11 -2) -13 13"),
+      TTYPE("1 -2",{{5,6}},0,"1 -2")
+    };
+
+  int cnt(1);
+  for(const TTYPE& tc : Tests)
+    {
+      HeadRule A(std::get<0>(tc));
+      const HeadRule C(std::get<3>(tc));
+      const int nOut=A.substituteSurf(std::get<1>(tc));
+      // operator== does not descend complement groups
+      if (nOut!=std::get<2>(tc) || A.display()!=C.display())
+	{
+	  ELog::EM<<"Failed on test "<<cnt<<ELog::endDiag;
+	  ELog::EM<<"N == "<<nOut<<" ("<<std::get<2>(tc)<<")"<<ELog::endDiag;
+	  ELog::EM<<"A == "<<A<<ELog::endDiag;
+	  ELog::EM<<"C == "<<C<<ELog::endDiag;
+	  return -1;
+	}
+      cnt++;
+    }
+  return 0;
+}
+
 int
 testHeadRule::testSurfSet()
   /*!
@@ -0,0 +1,170 @@
+ /********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testMarkovProcess.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <list>
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <functional>
+#include <tuple>
+
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "Vec3D.h"
+#include "dataSlice.h"
+#include "multiData.h"
+#include "BasicMesh3D.h"
+#include "WWGWeight.h"
+#include "WWG.h"
+#include "MarkovProcess.h"
+
+#include "testFunc.h"
+#include "testMarkovProcess.h"
+
+using namespace WeightSystem;
+
+testMarkovProcess::testMarkovProcess() 
+  /*!
+    Constructor
+  */
+{}
+
+testMarkovProcess::~testMarkovProcess() 
+  /*!
+    Destructor
+  */
+{}
+
+int 
+testMarkovProcess::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \retval -1 : MatrixCount
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","applyTest");
+  TestFunc::regSector("testMarkovProcess");
+
+  typedef int (testMarkovProcess::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testMarkovProcess::testMatrixCount
+    };
+  const std::string TestName[]=
+    {
+      "MatrixCount"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testMarkovProcess::testMatrixCount()
+  /*!
+    Test the number of stored pairs for an attenuation
+    that is linear in distance on a 6x5x4 unit mesh
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testMarkovProcess","testMatrixCount");
+
+  WWG wSet;
+  WWGWeight& wMesh=wSet.createMesh("test");
+  wMesh.setMesh(Geometry::Vec3D(0,0,0),Geometry::Vec3D(6,5,4),6,5,4);
+  const Geometry::BasicMesh3D& grid=wMesh.getGeomGrid();
+  const std::vector<Geometry::Vec3D> midPts=grid.midPoints();
+  const size_t NPts(midPts.size());
+
+  // attenuation per cm : max radius [0 for default] : threads
+  typedef std::tuple<double,double,size_t> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(15.0,0.0,1),      // face neighbours only
+      TTYPE(8.0,0.0,1),
+      TTYPE(8.0,0.0,3),
+      TTYPE(1.0,1.5,2),       // radius limit
+      TTYPE(0.1,0.0,1)        // every pair [within 10 steps]
+    };
+
+  for(const auto& [mu,radius,nThread] : Tests)
+    {
+      auto logFactor=[&midPts,mu](const size_t i,const size_t j)
+	{
+	  return -mu*midPts[i].Distance(midPts[j]);
+	};
+
+      // direct count over all pairs
+      size_t expect(0);
+      for(size_t i=0;i<NPts;i++)
+	for(size_t j=i+1;j<NPts;j++)
+	  if (logFactor(i,j)>-20.0 &&
+	      (radius<1e-6 || midPts[i].Distance(midPts[j])<=radius))
+	    expect++;
+      
+      MarkovProcess MP;
+      MP.setMaxRadius(radius);
+      MP.initializeData(wSet,"test");
+      MP.buildMatrix(nThread,grid,logFactor);
+      if (MP.getNElements()!=expect)
+	{
+	  ELog::EM<<"Mu/Radius == "<<mu<<" "<<radius<<ELog::endDiag;
+	  ELog::EM<<"Pairs     == "<<MP.getNElements()<<ELog::endDiag;
+	  ELog::EM<<"Expected  == "<<expect<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
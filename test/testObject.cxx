@@ -40,6 +40,7 @@
 #include "OutputLog.h"
 #include "support.h"
 #include "Vec3D.h"
+#include "BBox.h"
 #include "Rules.h"
 #include "BnId.h"
 #include "AcompTools.h"
@@ -175,7 +176,9 @@ testObject::applyTest(const int extra)
   typedef int (testObject::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObject::testBoundBox,
       &testObject::testCellStr,
+      &testObject::testCofM,
       &testObject::testComplement,
       &testObject::testIsValid,
       &testObject::testIsOnSide,
@@ -189,7 +192,9 @@ testObject::applyTest(const int extra)
     };
   const std::string TestName[]=
     {
+      "BoundBox",
       "CellStr",
+      "CofM",
       "Complement",
       "IsValid",
       "IsOnSide",
@@ -227,6 +232,72 @@ testObject::applyTest(const int extra)
 }
 
 
+int
+testObject::testBoundBox()
+  /*!
+    Test the bounding box of an object
+    \retval -1 :: failed box
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testBoundBox");
+
+  createSurfaces();
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+  // rotated square [vertex (+/-2,0) (0,+/-2)]
+  SurI.createSurface(31,"p 1 1 0 -2");
+  SurI.createSurface(32,"p 1 1 0 2");
+  SurI.createSurface(33,"p -1 1 0 -2");
+  SurI.createSurface(34,"p -1 1 0 2");
+
+  // Object : infinite : low : high
+  typedef std::tuple<std::string,bool,Geometry::Vec3D,Geometry::Vec3D> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("4 10 0.05 1 -2 3 -4 5 -6",0,
+	    Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(1,1,1)),
+      TTYPE("4 10 0.05 -101",0,
+	    Geometry::Vec3D(-5,-5,-5),Geometry::Vec3D(5,5,5)),
+      TTYPE("4 10 0.05 11 -12 13 -14 15 -16 (-1:2:-3:4:-5:6)",0,
+	    Geometry::Vec3D(-3,-3,-3),Geometry::Vec3D(3,3,3)),
+      TTYPE("4 10 0.05 (1 -2 3 -4 5 -6) : (21 -22 3 -4 5 -6)",0,
+	    Geometry::Vec3D(-1,-1,-1),Geometry::Vec3D(15,1,1)),
+      TTYPE("4 10 0.05 31 -32 33 -34 5 -6",0,
+	    Geometry::Vec3D(-2,-2,-1),Geometry::Vec3D(2,2,1)),
+      TTYPE("4 10 0.05 31 -32 33 -34",1,
+	    Geometry::Vec3D(0,0,0),Geometry::Vec3D(0,0,0)),
+      TTYPE("4 10 0.05 -1 : 2",1,
+	    Geometry::Vec3D(0,0,0),Geometry::Vec3D(0,0,0))
+    };
+
+  const double tol(1e-4);
+  for(const auto& [cellStr,infFlag,lowPt,highPt] : Tests)
+    {
+      Object A;
+      A.setObject(cellStr);
+      A.createSurfaceList();
+      const Geometry::BBox Box=A.getBoundBox();
+      if (!A.hasBoundBox() || Box.isInfinite()!=infFlag ||
+	  (!infFlag && (Box.getLow().Distance(lowPt)>tol ||
+			Box.getHigh().Distance(highPt)>tol)))
+	{
+	  ELog::EM<<"Cell = "<<cellStr<<ELog::endDiag;
+	  ELog::EM<<"Box  = "<<Box<<ELog::endDiag;
+	  ELog::EM<<"Expect = "<<lowPt<<" : "<<highPt
+		  <<" ("<<infFlag<<")"<<ELog::endDiag;
+	  return -1;
+	}
+      // points outside the box must not be valid
+      if (!infFlag && A.isValid(highPt+Geometry::Vec3D(0.1,0.1,0.1)))
+	{
+	  ELog::EM<<"Cell = "<<cellStr<<ELog::endDiag;
+	  ELog::EM<<"Valid outside box "<<Box<<ELog::endDiag;
+	  return -2;
+	}
+    }
+  return 0;
+}
+
 int
 testObject::testCellStr()
   /*!
@@ -364,6 +435,63 @@ testObject::testSetObjectExtra()
   return 0;
 }
 
+int
+testObject::testCofM()
+  /*!
+    Test the cached centre of mass is reset with the HeadRule
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testObject","testCofM");
+
+  createSurfaces();
+
+  Object A;
+  A.setObject("4 10 0.05 1 -2 3 -4 5 -6");
+  A.createSurfaceList();
+  if (A.hasCofM() ||
+      A.getCofM().Distance(Geometry::Vec3D(0,0,0))>1e-5 ||
+      !A.hasCofM())
+    {
+      ELog::EM<<"CofM  = "<<A.getCofM()<<ELog::endDiag;
+      return -1;
+    }
+
+  // copy keeps the cache
+  Object B(A);
+  if (!B.hasCofM())
+    {
+      ELog::EM<<"CofM not copied"<<ELog::endDiag;
+      return -1;
+    }
+  
+  A.procString("2 -21 3 -4 5 -6");
+  A.createSurfaceList();
+  if (A.hasCofM() ||
+      A.getCofM().Distance(Geometry::Vec3D(5.5,0,0))>1e-5)
+    {
+      ELog::EM<<"CofM  = "<<A.getCofM()<<ELog::endDiag;
+      return -2;
+    }
+
+  // moved surfaces / complement drop the cache
+  A.clearBoundBox();
+  if (A.hasCofM())
+    {
+      ELog::EM<<"CofM kept after clearBoundBox"<<ELog::endDiag;
+      return -3;
+    }
+  A.getCofM();
+  A.makeComplement();
+  if (A.hasCofM())
+    {
+      ELog::EM<<"CofM kept after makeComplement"<<ELog::endDiag;
+      return -3;
+    }
+  return 0;
+}
+
 int
 testObject::testComplement() 
   /*!
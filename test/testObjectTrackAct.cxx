@@ -57,6 +57,11 @@
 #include "SimMCNP.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
+#include "Zaid.h"
+#include "MXcards.h"
+#include "Material.h"
+#include "DBMaterial.h"
+#include "AttnTable.h"
 #include "LineUnit.h"
 #include "LineTrack.h"
 #include "ObjectTrackAct.h"
@@ -185,10 +190,12 @@ testObjectTrackAct::applyTest(const int extra)
   typedef int (testObjectTrackAct::*testPtr)();
   testPtr TPtr[]=
     {
+      &testObjectTrackAct::testAttnTable,
       &testObjectTrackAct::testPointDet
     };
   const std::string TestName[]=
     {
+      "AttnTable",
       "PointDet"
     };
   
@@ -217,6 +224,69 @@ testObjectTrackAct::applyTest(const int extra)
   return 0;
 }
 
+int
+testObjectTrackAct::testAttnTable()
+  /*!
+    Check the table values against the direct calculation
+    with and without the energy scaling
+    \return 0 on success and -1 on error
+  */
+{
+  ELog::RegMethod RegA("testObjectTrackAct","testAttnTable");
+
+  const DBMaterial& DB=DBMaterial::Instance();
+  AttnTable& AT=AttnTable::Instance();
+
+  // Material : Energy [group centre] : expected row exists
+  typedef std::tuple<std::string,double,bool> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE("H2O",1e-6,1),
+      TTYPE("H2O",14.0,1),
+      TTYPE("Aluminium",2.53e-8,1),
+      TTYPE("Void",1.0,1)
+    };
+
+  const double NDecade(static_cast<double>(AttnTable::nPerDecade));
+  for(const bool energyFlag : {true,false})
+    {
+      AT.setEnergyScale(energyFlag);
+      AT.build();
+      for(const TTYPE& tc : Tests)
+	{
+	  const MonteCarlo::Material& MObj=
+	    DB.getMaterial(std::get<0>(tc));
+	  const double E=std::get<1>(tc);
+	  // energy at the centre of its group:
+	  const size_t G=AT.getGroup(E);
+	  const double EMid=AttnTable::EMin*
+	    std::pow(10.0,(static_cast<double>(G)+0.5)/NDecade);
+	  const double direct=AT.calcAttn(MObj,EMid);
+	  const double table=AT.getAttn(MObj,E);
+	  if ((AT.getRow(MObj)!=0)!=std::get<2>(tc) ||
+	      std::abs(direct-table)>1e-12*(1.0+direct))
+	    {
+	      ELog::EM<<"Material "<<std::get<0>(tc)<<" E="<<E<<" G="<<G
+		      <<" energyScale="<<energyFlag<<ELog::endDiag;
+	      ELog::EM<<"Direct "<<direct<<" table "<<table<<ELog::endDiag;
+	      return -1;
+	    }
+	}
+      // Higher energy must not attenuate more [same if not scaled]
+      const MonteCarlo::Material& MObj=DB.getMaterial("H2O");
+      const double ALow=AT.getAttn(MObj,1e-8);
+      const double AHigh=AT.getAttn(MObj,1.0);
+      if (AHigh<=0.0 || (energyFlag && ALow<=AHigh) ||
+	  (!energyFlag && ALow!=AHigh))
+	{
+	  ELog::EM<<"Energy order wrong : "<<ALow<<" "<<AHigh
+		  <<" energyScale="<<energyFlag<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
 int
 testObjectTrackAct::testPointDet()
   /*!
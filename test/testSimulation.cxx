@@ -34,6 +34,7 @@
 #include <numeric>
 #include <iterator>
 #include <memory>
+#include <atomic>
 #include <tuple>
 
 #include "FileReport.h"
@@ -43,6 +44,7 @@
 #include "BaseVisit.h"
 #include "BaseModVisit.h"
 #include "Vec3D.h"
+#include "BBox.h"
 #include "surfIndex.h"
 #include "varList.h"
 #include "Code.h"
@@ -51,6 +53,7 @@
 #include "Importance.h"
 #include "Object.h"
 #include "ObjSurfMap.h"
+#include "CellBVH.h"
 #include "surfRegister.h"
 #include "ModelSupport.h"
 #include "Process.h"
@@ -176,13 +179,17 @@ testSimulation::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testSimulation::testCreateObjSurfMap,
+      &testSimulation::testFindCellBVH,
       &testSimulation::testInCell,
+      &testSimulation::testMinimizeThreads,
       &testSimulation::testSplitCell
     };
   const std::string TestName[]=
     {
       "CreateObjSurfMap",
+      "FindCellBVH",
       "InCell",
+      "MinimizeThreads",
       "SplitCell"
     };
   
@@ -251,6 +258,78 @@ testSimulation::testCreateObjSurfMap()
   return 0;  
 }
 
+int
+testSimulation::testFindCellBVH()
+  /*!
+    Test that the cell box tree finds the same cell as 
+    a full search of all the cells
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testFindCellBVH");
+
+  initSim();
+  ASim.createObjSurfMap();
+  const ModelSupport::CellBVH& BVH=ASim.getCellBVH();
+  if (!BVH.isBuilt())
+    {
+      ELog::EM<<"Cell BVH not built"<<ELog::endDiag;
+      return -1;
+    }
+  BVH.resetCount();
+
+  const Simulation::OTYPE& OList=ASim.getCells();
+  size_t nPoints(0);
+  for(double x=-31.3;x<32.0;x+=2.7)
+    for(double y=-31.1;y<32.0;y+=3.1)
+      for(double z=-30.7;z<32.0;z+=4.3)
+	{
+	  const Geometry::Vec3D Pt(x,y,z);
+	  const MonteCarlo::Object* OPtr=ASim.findCell(Pt,0);
+	  const MonteCarlo::Object* FPtr(0);
+	  for(const auto& [CN,objPtr] : OList)
+	    if (objPtr->isValid(Pt))
+	      {
+		FPtr=objPtr;
+		break;
+	      }
+	  if (OPtr!=FPtr)
+	    {
+	      ELog::EM<<"Failed on point: "<<Pt<<ELog::endDiag;
+	      ELog::EM<<"BVH cell == "<<(OPtr ? OPtr->getName() : 0)
+		      <<" Full cell == "<<(FPtr ? FPtr->getName() : 0)
+		      <<ELog::endDiag;
+	      return -1;
+	    }
+	  nPoints++;
+	}
+  // most points are found by the track cell but the
+  // tree must not test every cell on a miss
+  if (BVH.getNTested()>=BVH.getNQuery()*OList.size())
+    {
+      ELog::EM<<"BVH tested too many cells: "<<BVH<<ELog::endDiag;
+      ELog::EM<<"Points == "<<nPoints<<ELog::endDiag;
+      return -2;
+    }
+
+  // changing a bound cell must invalidate the tree
+  MonteCarlo::Object* CPtr=ASim.findObject(3);
+  const HeadRule CRule(CPtr->getHeadRule());
+  CPtr->procHeadRule(CRule);
+  if (BVH.isBuilt())
+    {
+      ELog::EM<<"Cell BVH valid after rule change"<<ELog::endDiag;
+      return -3;
+    }
+  ASim.createObjSurfMap();
+  if (!BVH.isBuilt())
+    {
+      ELog::EM<<"Cell BVH not rebuilt"<<ELog::endDiag;
+      return -4;
+    }
+  return 0;
+}
+
 int
 testSimulation::testInCell()
   /*!
@@ -295,6 +374,65 @@ testSimulation::testInCell()
   return 0;
 }
 
+int
+testSimulation::testMinimizeThreads()
+  /*!
+    Test that the threaded minimization of a group of
+    cells gives the same cells as the serial one
+    \return 0 on success / -1 on failure
+  */
+{
+  ELog::RegMethod RegA("testSimulation","testMinimizeThreads");
+
+  // Cells with redundant [parallel plane] or empty parts 
+  const std::vector<std::string> CellStr=
+    {
+      "11 21 -12 13 -14 15 -16",       // 21 redundant
+      "-21 11 13 -14 15 -16",          // empty
+      "31 -32 23 13 -14 -24 15 -16",   // 23/-24 redundant
+      "21 -22 23 -24 25 -26 (-11:12:-13:14:-15:16)",
+      "-31 22 -14 13 15 -16"
+    };
+
+  std::map<size_t,std::map<int,std::string>> Result;
+  for(const size_t NThread : {1UL,4UL})
+    {
+      ASim.resetAll();
+      createSurfaces();
+      int cellIndex(2);
+      for(const std::string& CS : CellStr)
+	ASim.addCell(MonteCarlo::Object
+		     (cellIndex++,0,0.0,ModelSupport::getComposite(0,CS)));
+      ASim.createObjSurfMap();
+      ASim.setThreads(NThread);
+      ASim.minimizeObject("World");
+      // changed cells must not leave the tree stale
+      if (!ASim.getCellBVH().isBuilt())
+	{
+	  ELog::EM<<"Cell BVH not rebuilt after minimize"<<ELog::endDiag;
+	  return -1;
+	}
+
+      std::map<int,std::string>& RMap=Result[NThread];
+      for(const auto& [CN,OPtr] : ASim.getCells())
+	RMap.emplace(CN,OPtr->getHeadRule().display());
+    }
+
+  const std::map<int,std::string>& SMap=Result[1];
+  const std::map<int,std::string>& TMap=Result[4];
+  if (SMap.find(3)!=SMap.end() || SMap.find(2)==SMap.end() ||
+      SMap!=TMap)
+    {
+      for(const auto& [CN,HRStr] : SMap)
+	ELog::EM<<"Serial["<<CN<<"] == "<<HRStr<<ELog::endDiag;
+      for(const auto& [CN,HRStr] : TMap)
+	ELog::EM<<"Thread["<<CN<<"] == "<<HRStr<<ELog::endDiag;
+      return -1;
+    }
+  ASim.setThreads(1);
+  return 0;
+}
+
 int
 testSimulation::testSplitCell()
   /*!
@@ -43,7 +43,10 @@
 #include "BaseModVisit.h"
 #include "MatrixBase.h"
 #include "Matrix.h"
+#include "Vec3D.h"
 #include "Surface.h"
+#include "Quadratic.h"
+#include "Plane.h"
 #include "surfIndex.h"
 #include "surfEqual.h"
 
@@ -107,13 +110,15 @@ testSurfEqual::applyTest(const int extra)
   testPtr TPtr[]=
     {
       &testSurfEqual::testBasicPair,
-      &testSurfEqual::testEqualSurfNum
+      &testSurfEqual::testEqualSurfNum,
+      &testSurfEqual::testHashIndex
     };
 
   const std::string TestName[]=
     {
       "BasicPair",
-      "EqualSurfNum"
+      "EqualSurfNum",
+      "HashIndex"
     };
 
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -202,3 +207,62 @@ testSurfEqual::testEqualSurfNum()
   return 0;
 }
 
+int
+testSurfEqual::testHashIndex()
+  /*!
+    Test the hash index of surfIndex finds equal/opposite 
+    surfaces across the quantisation boundaries. Lowest
+    surface number must be returned.
+    \return -ve on error 
+  */
+{
+  ELog::RegMethod RegA("testSurfEqual","testHashIndex");
+
+  ModelSupport::surfIndex& SurI=ModelSupport::surfIndex::Instance();
+
+  SurI.createSurface(101,"px 0.002000000004");
+  SurI.createSurface(102,"px 0.001999999996");
+  SurI.createSurface(103,"p -1 0 0 -0.002");
+  SurI.createSurface(104,"cx 2.5");
+  SurI.createSurface(105,"c/x 0.0 0.0 2.5");
+  SurI.createSurface(106,"px 2.5");
+  // set after creation :
+  Geometry::Plane* PPtr=SurI.createSurf<Geometry::Plane>(107);
+  PPtr->setPlane(Geometry::Vec3D(1,0,0),0.002);
+  
+  // surface : equal : opposite
+  typedef std::tuple<int,int,int> TTYPE;
+  const std::vector<TTYPE> Tests({
+      TTYPE(101,101,103),
+      TTYPE(102,101,103),
+      TTYPE(103,103,101),
+      TTYPE(104,104,0),
+      TTYPE(105,104,0),
+      TTYPE(106,106,0),
+      TTYPE(107,101,103),
+      TTYPE(11,11,1)
+    });
+
+  int retFlag(0);
+  for(const TTYPE& tc : Tests)
+    {
+      const Geometry::Surface* SA=SurI.getSurf(std::get<0>(tc));
+      const int eqN=ModelSupport::equalSurfNum(SA);
+      const int oppN=SurI.findOpposite(SA);
+      if (eqN!=std::get<1>(tc) || oppN!=std::get<2>(tc))
+	{
+	  ELog::EM<<"Failed :  "<<std::get<0>(tc)<<ELog::endCrit;
+	  ELog::EM<<"Surface :  "<<*SA<<ELog::endCrit;
+	  ELog::EM<<"Equal    : "<<eqN<<" ("<<std::get<1>(tc)<<")"
+		  <<ELog::endCrit;
+	  ELog::EM<<"Opposite : "<<oppN<<" ("<<std::get<2>(tc)<<")"
+		  <<ELog::endCrit;
+	  retFlag=-1;
+	  break;
+	}
+    }
+  for(int SN=101;SN<108;SN++)
+    SurI.deleteSurface(SN);
+  
+  return retFlag;
+}
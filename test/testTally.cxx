@@ -47,6 +47,7 @@
 #include "support.h"
 #include "Tally.h"
 #include "pointTally.h"
+#include "sswTally.h"
 
 #include "testFunc.h"
 #include "testTally.h"
@@ -86,7 +87,8 @@ testTally::applyTest(const int extra)
       &testTally::testFirstLine,
       &testTally::testFuCard,
       &testTally::testGetElm,
-      &testTally::testGetID
+      &testTally::testGetID,
+      &testTally::testRenumberSurf
 
     };
   const std::string TestName[]=
@@ -96,7 +98,8 @@ testTally::applyTest(const int extra)
       "FirstLine",
       "FuCard",
       "GetElm",
-      "GetID"
+      "GetID",
+      "RenumberSurf"
     };
   
   const int TSize(sizeof(TPtr)/sizeof(testPtr));
@@ -329,3 +332,30 @@ testTally::testFuCard()
 
   return 0;
 }
+
+int
+testTally::testRenumberSurf() 
+  /*!
+    Test a surface renumber map where a new number
+    is also an old number [each surface changed once]
+    \retval -1 :: failed
+    \retval 0 :: success
+  */
+{
+  ELog::RegMethod RegA("testTally","testRenumberSurf");
+
+  sswTally A(1);
+  A.addSurfaces({1,2,-1,5,-2});
+  A.renumberSurf(std::map<int,int>({{1,2},{2,3}}));
+
+  std::ostringstream cx;
+  A.write(cx);
+  const std::string Out=StrFunc::singleLine(cx.str());
+  if (Out!="ssw 2 3 -2 5 -3")
+    {
+      ELog::EM<<"Renumber == "<<Out<<ELog::endDiag;
+      ELog::EM<<"Expected == ssw 2 3 -2 5 -3"<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
@@ -0,0 +1,278 @@
+ /********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   test/testWWGOctree.cxx
+ *
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include <complex> 
+#include <vector>
+#include <map> 
+#include <set>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <array>
+
+#include "FileReport.h"
+#include "NameStack.h"
+#include "RegMethod.h"
+#include "OutputLog.h"
+#include "Vec3D.h"
+#include "WWGOctree.h"
+
+#include "testFunc.h"
+#include "testWWGOctree.h"
+
+using namespace WeightSystem;
+
+testWWGOctree::testWWGOctree() 
+  /*!
+    Constructor
+  */
+{}
+
+testWWGOctree::~testWWGOctree() 
+  /*!
+    Destructor
+  */
+{}
+
+int 
+testWWGOctree::applyTest(const int extra)
+  /*!
+    Applies all the tests and returns 
+    the error number
+    \param extra :: Test number to run
+    \retval -1 : AxisDepth
+    \retval 0 : All succeeded
+  */
+{
+  ELog::RegMethod RegA("testWWGOctree","applyTest");
+  TestFunc::regSector("testWWGOctree");
+
+  typedef int (testWWGOctree::*testPtr)();
+  testPtr TPtr[]=
+    {
+      &testWWGOctree::testAxisDepth,
+      &testWWGOctree::testFindLeaf,
+      &testWWGOctree::testRefine
+    };
+  const std::string TestName[]=
+    {
+      "AxisDepth",
+      "FindLeaf",
+      "Refine"
+    };
+  
+  const int TSize(sizeof(TPtr)/sizeof(testPtr));
+  if (!extra)
+    {
+      std::ios::fmtflags flagIO=std::cout.setf(std::ios::left);
+      for(int i=0;i<TSize;i++)
+        {
+	  std::cout<<std::setw(30)<<TestName[i]<<"("<<i+1<<")"<<std::endl;
+	}
+      std::cout.flags(flagIO);
+      return 0;
+    }
+
+  for(int i=0;i<TSize;i++)
+    {
+      if (extra<0 || extra==i+1)
+        {
+	  TestFunc::regTest(TestName[i]);
+	  const int retValue= (this->*TPtr[i])();
+	  if (retValue || extra>0)
+	    return retValue;
+	}
+    }
+  return 0;
+}
+
+int
+testWWGOctree::testFindLeaf()
+  /*!
+    Test a uniform tree [no refinement] 
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testWWGOctree","testFindLeaf");
+
+  // linear in x : every step is below threshold
+  auto linearFunc=[](const Geometry::Vec3D& Pt) -> std::vector<double>
+    {
+      return {-Pt.X(),-2.0*Pt.X()};
+    };
+
+  WWGOctree OTree(2,4,10.0);
+  OTree.build(Geometry::Vec3D(0,0,0),Geometry::Vec3D(8,8,8),
+	      2,1,linearFunc);
+
+  if (OTree.getNLeaf()!=64 || OTree.getNEval()!=64)
+    {
+      ELog::EM<<"Leaf  == "<<OTree.getNLeaf()<<ELog::endDiag;
+      ELog::EM<<"NEval == "<<OTree.getNEval()<<ELog::endDiag;
+      return -1;
+    }
+
+  // Point : expected centre x value
+  typedef std::tuple<Geometry::Vec3D,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(Geometry::Vec3D(0.5,3,7),1.0),
+      TTYPE(Geometry::Vec3D(2.0,0,0),3.0),
+      TTYPE(Geometry::Vec3D(7.9,7.9,7.9),7.0),
+      TTYPE(Geometry::Vec3D(8,8,8),7.0)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const double* VPt=OTree.getValue(std::get<0>(tc));
+      if (!VPt ||
+	  std::abs(VPt[0]+std::get<1>(tc))>1e-8 ||
+	  std::abs(VPt[1]+2.0*std::get<1>(tc))>1e-8)
+	{
+	  ELog::EM<<"Point    == "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Expected == "<<-std::get<1>(tc)<<ELog::endDiag;
+	  if (VPt)
+	    ELog::EM<<"Value    == "<<VPt[0]<<" "<<VPt[1]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+
+  if (OTree.getValue(Geometry::Vec3D(-1,4,4)) ||
+      OTree.findLeaf(Geometry::Vec3D(4,4,9))!=OTree.getNNode())
+    {
+      ELog::EM<<"Outside point found"<<ELog::endDiag;
+      return -1;
+    }
+  return 0;
+}
+
+int
+testWWGOctree::testRefine()
+  /*!
+    Test the refinement about a step in the weight
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testWWGOctree","testRefine");
+
+  const double stepX(3.3);
+  auto stepFunc=[stepX](const Geometry::Vec3D& Pt) -> std::vector<double>
+    {
+      return {(Pt.X()<stepX) ? 0.0 : -5.0};
+    };
+
+  const size_t maxDepth(5);
+  WWGOctree OTree(1,maxDepth,2.0);
+  OTree.build(Geometry::Vec3D(0,0,0),Geometry::Vec3D(8,8,8),
+	      2,4,stepFunc);
+
+  // uniform grid at max depth
+  const size_t fullEval(1 << (3*maxDepth));
+  if (OTree.getNEval()>=fullEval/4 || OTree.getNLeaf()<=64)
+    {
+      ELog::EM<<"NEval == "<<OTree.getNEval()<<" ["
+	      <<fullEval<<"]"<<ELog::endDiag;
+      ELog::EM<<"Leaf  == "<<OTree.getNLeaf()<<ELog::endDiag;
+      return -1;
+    }
+
+  // values on each side of the step [cell width 0.25]
+  typedef std::tuple<Geometry::Vec3D,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(Geometry::Vec3D(0.5,1,1),0.0),
+      TTYPE(Geometry::Vec3D(3.1,4,6),0.0),
+      TTYPE(Geometry::Vec3D(3.55,2,2),-5.0),
+      TTYPE(Geometry::Vec3D(7.5,7,7),-5.0)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const double* VPt=OTree.getValue(std::get<0>(tc));
+      if (!VPt || std::abs(VPt[0]-std::get<1>(tc))>1e-8)
+	{
+	  ELog::EM<<"Point    == "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Expected == "<<std::get<1>(tc)<<ELog::endDiag;
+	  if (VPt)
+	    ELog::EM<<"Value    == "<<VPt[0]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
+
+int
+testWWGOctree::testAxisDepth()
+  /*!
+    Test the per-axis depth on a flat [64x8x1] mesh :
+    no leaf can be finer than one mesh cell on any axis
+    \return 0 on success
+  */
+{
+  ELog::RegMethod RegA("testWWGOctree","testAxisDepth");
+
+  auto stepFunc=[](const Geometry::Vec3D& Pt) -> std::vector<double>
+    {
+      return {(Pt.Y()<3.0) ? 0.0 : -5.0};
+    };
+
+  WWGOctree OTree(1,6,2.0);
+  OTree.setAxisDepth({6,3,0});
+  OTree.build(Geometry::Vec3D(0,0,0),Geometry::Vec3D(64,8,1),
+	      2,2,stepFunc);
+
+  // full mesh is 64x8x1
+  if (OTree.getNLeaf()>512 || OTree.getNLeaf()<=16)
+    {
+      ELog::EM<<"Leaf  == "<<OTree.getNLeaf()<<ELog::endDiag;
+      ELog::EM<<"NEval == "<<OTree.getNEval()<<ELog::endDiag;
+      return -1;
+    }
+
+  // Point : expected value
+  typedef std::tuple<Geometry::Vec3D,double> TTYPE;
+  const std::vector<TTYPE> Tests=
+    {
+      TTYPE(Geometry::Vec3D(0.5,2.9,0.1),0.0),
+      TTYPE(Geometry::Vec3D(40.0,2.9,0.9),0.0),
+      TTYPE(Geometry::Vec3D(0.5,3.1,0.5),-5.0),
+      TTYPE(Geometry::Vec3D(63.0,7.9,0.5),-5.0)
+    };
+
+  for(const TTYPE& tc : Tests)
+    {
+      const double* VPt=OTree.getValue(std::get<0>(tc));
+      if (!VPt || std::abs(VPt[0]-std::get<1>(tc))>1e-8)
+	{
+	  ELog::EM<<"Point    == "<<std::get<0>(tc)<<ELog::endDiag;
+	  ELog::EM<<"Expected == "<<std::get<1>(tc)<<ELog::endDiag;
+	  if (VPt)
+	    ELog::EM<<"Value    == "<<VPt[0]<<ELog::endDiag;
+	  return -1;
+	}
+    }
+  return 0;
+}
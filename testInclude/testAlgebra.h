@@ -55,6 +55,7 @@ private:
   int testMult();
   int testResolveTrue();
   int testSetFunction();
+  int testSetFunctionObj();
   int testSetFunctionObjStr();
   int testSubtract();
   int testWeakDiv();     ///< test the weak division
@@ -40,6 +40,7 @@ private:
   //Tests 
   int testAddInterUnion();
   int testCalcSurfIntersection();
+  int testCompiledEval();
   int testCountLevel();
   int testEqual();
   int testFindNodes();
@@ -54,6 +55,7 @@ private:
   int testPartEqual();
   int testRemoveSurf();
   int testReplacePart();
+  int testSubstituteSurf();
   int testSurfValid();
   int testSurfSet();
  
@@ -0,0 +1,51 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   testInclude/testMarkovProcess.h
+*
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testMarkovProcess_h
+#define testMarkovProcess_h 
+
+/*!
+  \class testMarkovProcess
+  \brief Tests the sparse Markov transfer matrix
+  \author S. Ansell
+  \date October 2026
+  \version 1.0
+
+  Test the pair selection using an analytic attenuation
+*/
+
+class testMarkovProcess
+{
+private:
+  
+  //Tests 
+  int testMatrixCount();
+
+public:
+  
+  testMarkovProcess();
+  ~testMarkovProcess();
+  
+  int applyTest(const int);       
+
+};
+
+#endif
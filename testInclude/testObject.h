@@ -46,7 +46,9 @@ private:
   void createSurfaces();
 
   //Tests 
+  int testBoundBox();
   int testCellStr();
+  int testCofM();
   int testComplement();
   int testIsValid();
   int testIsOnSide();
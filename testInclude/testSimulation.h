@@ -44,7 +44,9 @@ private:
 
   //Tests 
   int testCreateObjSurfMap();
+  int testFindCellBVH();
   int testInCell();
+  int testMinimizeThreads();
   int testSplitCell();
 
 public:
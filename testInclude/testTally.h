@@ -43,6 +43,7 @@ private:
   int testFuCard();
   int testGetElm();
   int testGetID();
+  int testRenumberSurf();
 
 
 public:
@@ -0,0 +1,53 @@
+/********************************************************************* 
+  CombLayer : MCNP(X) Input builder
+ 
+ * File:   testInclude/testWWGOctree.h
+*
+ * Copyright (c) 2004-2026 by Stuart Ansell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>. 
+ *
+ ****************************************************************************/
+#ifndef testWWGOctree_h
+#define testWWGOctree_h 
+
+/*!
+  \class testWWGOctree
+  \brief Tests the adaptive WWG octree
+  \author S. Ansell
+  \date October 2026
+  \version 1.0
+
+  Test the refinement using an analytic log-weight
+*/
+
+class testWWGOctree
+{
+private:
+  
+  //Tests 
+  int testAxisDepth();
+  int testFindLeaf();
+  int testRefine();
+
+public:
+  
+  testWWGOctree();
+  ~testWWGOctree();
+  
+  int applyTest(const int);       
+
+};
+
+#endif